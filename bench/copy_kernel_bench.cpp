@@ -0,0 +1,103 @@
+/// @file
+/// @brief Copy throughput into a shared segment of memcpy and of the streaming AVX2 kernel,
+/// and the cost of reloading the producer's working set afterwards, reported as JSON.
+/// @copyright (c) Jean Frantz René
+///
+/// Usage: general_inter_p_lib_copy_bench [max_bytes]
+/// Payloads go from 64 KB to max_bytes (64 MB by default) in steps of 4x.
+
+#include "copy_kernel.h"
+#include "shared_segment.h"
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t kWorkingSetBytes = 512U * 1024U;     ///< Data the producer keeps hot between frames.
+constexpr std::size_t kBytesPerRun = 1024U * 1024U * 1024U; ///< Bytes copied per measurement, bounding the iterations.
+
+/// Result of one measurement.
+struct Result
+{
+    CopyKernel kernel;      ///< Kernel measured.
+    std::size_t bytes;      ///< Payload size in bytes.
+    double throughput_gb_s; ///< Copy throughput.
+    double working_set_ns;  ///< Mean time to sum the working set after each copy.
+};
+
+/// Copy frames into the segment, each followed by a pass over the working set.
+Result measure(CopyKernel kernel, SharedSegment &segment, const std::vector<unsigned char> &frame,
+               std::vector<std::uint64_t> &working_set)
+{
+    auto *shared = segment.address();
+    const auto iterations = std::max<std::size_t>(kBytesPerRun / frame.size(), 4U);
+
+    std::chrono::steady_clock::duration copying{};
+    std::chrono::steady_clock::duration reloading{};
+    std::uint64_t checksum = 0U;
+    for (std::size_t i = 0U; i < iterations; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        copyBytes(shared, frame.data(), frame.size(), kernel);
+        const auto copied = std::chrono::steady_clock::now();
+        checksum += std::accumulate(working_set.begin(), working_set.end(), std::uint64_t{0U});
+        const auto reloaded = std::chrono::steady_clock::now();
+        copying += copied - start;
+        reloading += reloaded - copied;
+    }
+    // Keep the working set pass from being optimized away.
+    working_set[0] = checksum;
+
+    const std::chrono::duration<double> seconds = copying;
+    const std::chrono::duration<double, std::nano> nanoseconds = reloading;
+    return Result{kernel, frame.size(), static_cast<double>(frame.size() * iterations) / seconds.count() / 1e9,
+                  nanoseconds.count() / static_cast<double>(iterations)};
+}
+
+/// Print one result as a JSON object.
+void printJson(const Result &result, bool last)
+{
+    std::cout << "    {\"kernel\": \"" << (result.kernel == CopyKernel::Memcpy ? "memcpy" : "streaming_avx2")
+              << "\", \"bytes\": " << result.bytes
+              << ", \"throughput_gb_s\": " << result.throughput_gb_s
+              << ", \"working_set_reload_ns\": " << result.working_set_ns << "}"
+              << (last ? "\n" : ",\n");
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const std::size_t max_bytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64U * 1024U * 1024U;
+    const char *name = "general_inter_p_lib_copy_bench";
+
+    std::vector<std::uint64_t> working_set(kWorkingSetBytes / sizeof(std::uint64_t), 1U);
+    std::vector<Result> results;
+    for (std::size_t bytes = 64U * 1024U; bytes <= max_bytes; bytes *= 4U)
+    {
+        SharedSegment segment(name, bytes);
+        const std::vector<unsigned char> frame(bytes, 0x5A);
+        // Fault every page in before timing.
+        copyBytes(segment.address(), frame.data(), bytes, CopyKernel::Memcpy);
+        results.push_back(measure(CopyKernel::Memcpy, segment, frame, working_set));
+        results.push_back(measure(CopyKernel::StreamingAvx2, segment, frame, working_set));
+    }
+
+    std::cout << "{\n  \"benchmark\": \"general_inter_p_lib_copy_bench\",\n"
+              << "  \"streaming_kernel\": \"" << (streamingCopyKernel() == CopyKernel::Memcpy ? "memcpy" : "streaming_avx2") << "\",\n"
+              << "  \"streaming_threshold_bytes\": " << kStreamingCopyThreshold << ",\n  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        printJson(results[i], i + 1U == results.size());
+    }
+    std::cout << "  ]\n}\n";
+    boost::interprocess::shared_memory_object::remove(name);
+    return 0;
+}
@@ -0,0 +1,296 @@
+/// @file
+/// @brief Producer/consumer benchmark across processes: forks N producers and M consumers,
+/// optionally pinned to CPUs, drives one SharedMemory channel for a fixed duration and
+/// reports throughput, dropped frames and per-consumer latency as JSON.
+/// A read consumes the frame, so the consumers share the frames instead of each receiving
+/// every one: a frame is dropped when it is overwritten before any consumer read it.
+/// @copyright (c) Jean Frantz René
+///
+/// Usage: general_inter_p_lib_cross_process_bench [--producers N] [--consumers M] [--seconds S]
+///        [--cpus 0,1,...] [--notification condition|futex] [--rate frames_per_s]
+/// CPUs are assigned round robin, producers first. A rate of 0 writes as fast as possible.
+
+#include "latency_histogram.h"
+#include "shared_memory.h"
+#include "shared_segment.h"
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+constexpr std::size_t kMaxProcesses = 64U;
+const char *const kChannelName = "general_inter_p_lib_xproc_channel";
+const char *const kResultsName = "general_inter_p_lib_xproc_results";
+
+/// Command line settings.
+struct Settings
+{
+    std::size_t producers = 1U;                          ///< Number of producer processes.
+    std::size_t consumers = 1U;                          ///< Number of consumer processes.
+    double seconds = 2.0;                                ///< Duration of the run.
+    std::vector<int> cpus;                               ///< CPUs to pin the processes to, empty for no pinning.
+    Notification notification = Notification::Condition; ///< Wake-up mechanism of the channel.
+    double rate = 0.0;                                   ///< Frames per second per producer, 0 for flat out.
+};
+
+/// Counters of one consumer.
+struct ConsumerStats
+{
+    LatencyHistogram latency;            ///< Time from write to read.
+    std::atomic<std::uint64_t> consumed; ///< Number of frames read.
+};
+
+/// Block shared by the parent and its children through the results segment.
+struct Results
+{
+    std::atomic<bool> start{false};                                ///< Set once every child is forked.
+    std::atomic<bool> stop{false};                                 ///< Set when the duration has elapsed.
+    std::array<std::atomic<std::uint64_t>, kMaxProcesses> produced{}; ///< Frames written per producer.
+    std::array<ConsumerStats, kMaxProcesses> consumers{};             ///< Counters per consumer.
+};
+
+/// Pin the calling process to a CPU.
+void pin(int cpu)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0)
+    {
+        std::cerr << "Cannot pin process to CPU " << cpu << '\n';
+    }
+}
+
+/// Wait for the start signal of the parent.
+void waitForStart(const Results &results)
+{
+    while (!results.start.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+}
+
+/// Body of a producer process.
+void produce(Results &results, std::size_t id, const Settings &settings)
+{
+    SharedMemoryOptions options;
+    options.segment.open_mode = OpenMode::Attach;
+    SharedMemory<int> channel(kChannelName, sizeof(int), options);
+    waitForStart(results);
+
+    const auto period = settings.rate > 0.0 ? std::chrono::duration<double>(1.0 / settings.rate) : std::chrono::duration<double>::zero();
+    auto next = std::chrono::steady_clock::now();
+    int value = 0;
+    while (!results.stop.load(std::memory_order_relaxed))
+    {
+        channel.write(value++);
+        results.produced[id].fetch_add(1U, std::memory_order_relaxed);
+        if (settings.rate > 0.0)
+        {
+            next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+            std::this_thread::sleep_until(next);
+        }
+    }
+}
+
+/// Body of a consumer process.
+void consume(Results &results, std::size_t id)
+{
+    SharedMemoryOptions options;
+    options.segment.open_mode = OpenMode::Attach;
+    SharedMemory<int> channel(kChannelName, sizeof(int), options);
+    auto &stats = results.consumers[id];
+    waitForStart(results);
+
+    while (true)
+    {
+        auto loan = channel.acquire_read_slot();
+        const auto now = LatencyHistogram::now();
+        const auto published = loan.publish_ns();
+        loan.release();
+        if (results.stop.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        stats.latency.record(static_cast<std::uint64_t>(now - published));
+        stats.consumed.fetch_add(1U, std::memory_order_relaxed);
+    }
+}
+
+/// Parse the command line.
+Settings parse(int argc, char *argv[])
+{
+    Settings settings;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string flag = argv[i];
+        const std::string value = argv[i + 1];
+        if (flag == "--producers")
+        {
+            settings.producers = std::stoul(value);
+        }
+        else if (flag == "--consumers")
+        {
+            settings.consumers = std::stoul(value);
+        }
+        else if (flag == "--seconds")
+        {
+            settings.seconds = std::stod(value);
+        }
+        else if (flag == "--rate")
+        {
+            settings.rate = std::stod(value);
+        }
+        else if (flag == "--notification")
+        {
+            settings.notification = value == "futex" ? Notification::Futex : Notification::Condition;
+        }
+        else if (flag == "--cpus")
+        {
+            std::stringstream list(value);
+            std::string cpu;
+            while (std::getline(list, cpu, ','))
+            {
+                settings.cpus.push_back(std::stoi(cpu));
+            }
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown option " + flag);
+        }
+    }
+    if (settings.producers == 0U || settings.consumers == 0U || settings.producers > kMaxProcesses || settings.consumers > kMaxProcesses)
+    {
+        throw std::invalid_argument("Between 1 and 64 producers and consumers are supported");
+    }
+    return settings;
+}
+
+/// Fork a child running a function, pinned to the next CPU if any, and return its pid.
+template <typename Function>
+pid_t spawn(const Settings &settings, std::size_t slot, Function &&function)
+{
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+        if (!settings.cpus.empty())
+        {
+            pin(settings.cpus[slot % settings.cpus.size()]);
+        }
+        function();
+        // Skip the destructors of the parent's objects inherited by the fork.
+        _exit(EXIT_SUCCESS);
+    }
+    return pid;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Settings settings;
+    try
+    {
+        settings = parse(argc, argv);
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << '\n'
+                  << "Usage: " << argv[0] << " [--producers N] [--consumers M] [--seconds S] [--cpus 0,1,...]"
+                  << " [--notification condition|futex] [--rate frames_per_s]\n";
+        return EXIT_FAILURE;
+    }
+
+    SharedMemoryOptions channel_options;
+    channel_options.notification = settings.notification;
+    channel_options.latency_stats = true;
+    SharedMemory<int> channel(kChannelName, sizeof(int), channel_options);
+    SharedSegment segment(kResultsName, sizeof(Results));
+    auto *results = new (segment.address()) Results();
+
+    std::vector<pid_t> producers;
+    std::vector<pid_t> consumers;
+    for (std::size_t i = 0U; i < settings.producers; ++i)
+    {
+        producers.push_back(spawn(settings, i, [results, i, &settings]()
+                                  { produce(*results, i, settings); }));
+    }
+    for (std::size_t i = 0U; i < settings.consumers; ++i)
+    {
+        consumers.push_back(spawn(settings, settings.producers + i, [results, i]()
+                                  { consume(*results, i); }));
+    }
+
+    // Give the children time to attach before starting the clock.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    const auto start = std::chrono::steady_clock::now();
+    results->start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::duration<double>(settings.seconds));
+    results->stop.store(true, std::memory_order_relaxed);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    for (const auto pid : producers)
+    {
+        waitpid(pid, nullptr, 0);
+    }
+    // Consumers may be parked waiting for data: keep writing until every one has seen the stop flag.
+    std::size_t running = consumers.size();
+    while (running != 0U)
+    {
+        channel.write(-1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        for (auto &pid : consumers)
+        {
+            if (pid != 0 && waitpid(pid, nullptr, WNOHANG) == pid)
+            {
+                pid = 0;
+                --running;
+            }
+        }
+    }
+
+    std::uint64_t produced = 0U;
+    for (std::size_t i = 0U; i < settings.producers; ++i)
+    {
+        produced += results->produced[i].load();
+    }
+    std::uint64_t consumed = 0U;
+    for (std::size_t i = 0U; i < settings.consumers; ++i)
+    {
+        consumed += results->consumers[i].consumed.load();
+    }
+
+    std::cout << "{\n  \"benchmark\": \"general_inter_p_lib_cross_process_bench\",\n"
+              << "  \"producers\": " << settings.producers << ", \"consumers\": " << settings.consumers
+              << ", \"seconds\": " << elapsed.count()
+              << ", \"notification\": \"" << (settings.notification == Notification::Futex ? "futex" : "condition") << "\",\n"
+              << "  \"produced\": " << produced << ", \"consumed\": " << consumed
+              << ", \"dropped\": " << (produced > consumed ? produced - consumed : 0U)
+              << ", \"throughput_frames_per_s\": " << static_cast<double>(produced) / elapsed.count() << ",\n"
+              << "  \"consumers_stats\": [\n";
+    for (std::size_t i = 0U; i < settings.consumers; ++i)
+    {
+        const auto stats = results->consumers[i].latency.stats();
+        std::cout << "    {\"consumer\": " << i << ", \"consumed\": " << results->consumers[i].consumed.load()
+                  << ", \"latency_ns\": {\"p50\": " << stats.p50
+                  << ", \"p99\": " << stats.p99 << ", \"p999\": " << stats.p999 << ", \"max\": " << stats.max << "}}"
+                  << (i + 1U == settings.consumers ? "\n" : ",\n");
+    }
+    std::cout << "  ]\n}\n";
+
+    results->~Results();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,79 @@
+/// @file
+/// @brief Copy throughput of shared segments backed by 4 KB pages and by 2 MB huge pages.
+/// @copyright (c) Jean Frantz René
+
+#include "shared_segment.h"
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+/// Copy a frame into the segment and back out repeatedly, return the throughput in GB/s.
+double copyThroughput(SharedSegment &segment, std::vector<unsigned char> &frame, int iterations)
+{
+    auto *shared = static_cast<unsigned char *>(segment.address());
+
+    // Fault every page in before timing, so both backings are measured in steady state.
+    std::memset(shared, 0, frame.size());
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        frame[0] = static_cast<unsigned char>(i);
+        std::memcpy(shared, frame.data(), frame.size());
+        std::memcpy(frame.data(), shared, frame.size());
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto bytes = 2.0 * static_cast<double>(frame.size()) * iterations;
+    return bytes / elapsed.count() / 1e9;
+}
+} // namespace
+
+int main()
+{
+    const char *name = "general_inter_p_lib_hugepage_bench";
+    constexpr int kIterations = 50;
+
+    std::cout << std::left << std::setw(12) << "frame [MB]"
+              << std::setw(16) << "4 KB [GB/s]"
+              << std::setw(16) << "2 MB [GB/s]" << '\n';
+
+    bool huge_pages_available = true;
+    for (const std::size_t megabytes : {2U, 8U, 32U, 64U})
+    {
+        std::vector<unsigned char> frame(megabytes * 1024U * 1024U, 0x5A);
+
+        double small_pages = 0.0;
+        {
+            SharedSegment segment(name, frame.size());
+            small_pages = copyThroughput(segment, frame, kIterations);
+        }
+
+        double huge_pages = 0.0;
+        {
+            SegmentOptions options;
+            options.backing = SegmentBacking::HugePages;
+            SharedSegment segment(name, frame.size(), options);
+            huge_pages_available = huge_pages_available && segment.hugePages();
+            huge_pages = copyThroughput(segment, frame, kIterations);
+        }
+
+        std::cout << std::left << std::setw(12) << megabytes
+                  << std::setw(16) << std::fixed << std::setprecision(2) << small_pages
+                  << std::setw(16) << huge_pages << '\n';
+    }
+
+    if (!huge_pages_available)
+    {
+        std::cout << "\nNo huge pages reserved on /dev/hugepages, the 2 MB column fell back to 4 KB pages.\n"
+                  << "Reserve some with: echo 64 | sudo tee /proc/sys/vm/nr_hugepages\n";
+    }
+    boost::interprocess::shared_memory_object::remove(name);
+    return 0;
+}
@@ -0,0 +1,174 @@
+/// @file
+/// @brief Write/read throughput and latency between two threads of one process, reported as JSON:
+/// SharedMemory for int and float, SharedFlatMemory for std::vector<float> and Image<std::size_t>.
+/// The round trip from write to acknowledgement is timed for every type; the one-way latency
+/// from write to read only for SharedMemory, whose stats block records it.
+/// @copyright (c) Jean Frantz René
+///
+/// Usage: general_inter_p_lib_bench [max_bytes]
+/// Payloads go from 4 B to max_bytes (64 MB by default) in steps of 16x.
+
+#include "image.h"
+#include "latency_histogram.h"
+#include "shared_flat_memory.h"
+#include "shared_memory.h"
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t kBytesPerRun = 256U * 1024U * 1024U; ///< Bytes moved per measurement, bounding the iterations.
+constexpr std::size_t kMinIterations = 20U;
+constexpr std::size_t kMaxIterations = 20000U;
+
+/// Result of one measurement.
+struct Result
+{
+    std::string type;                    ///< Name of the channel type.
+    std::size_t bytes;                   ///< Payload size in bytes.
+    std::size_t iterations;              ///< Number of frames sent.
+    double seconds;                      ///< Wall time of the run.
+    LatencyStats round_trip;             ///< Time from write to the reader's acknowledgement.
+    std::optional<LatencyStats> latency; ///< One-way latency from write to read, SharedMemory only.
+};
+
+/// Channel carrying T: trivially copyable types are placed in the segment as is, the others
+/// in their flat layout.
+template <typename T>
+using ChannelFor = std::conditional_t<std::is_trivially_copyable_v<T>, SharedMemory<T>, SharedFlatMemory<T>>;
+
+/// Build a payload of about the given size.
+template <typename T>
+T makePayload(std::size_t bytes);
+
+template <>
+int makePayload<int>(std::size_t) { return 42; }
+
+template <>
+float makePayload<float>(std::size_t) { return 4.2F; }
+
+template <>
+std::vector<float> makePayload<std::vector<float>>(std::size_t bytes)
+{
+    return std::vector<float>(std::max<std::size_t>(bytes / sizeof(float), 1U), 1.0F);
+}
+
+template <>
+Image<std::size_t> makePayload<Image<std::size_t>>(std::size_t bytes)
+{
+    const auto pixels = std::max<std::size_t>(bytes / sizeof(std::size_t), 1U);
+    return Image<std::size_t>(std::vector<std::size_t>(pixels, 7U), pixels, 1U);
+}
+
+/// Create the channel for a payload.
+template <typename T>
+std::unique_ptr<ChannelFor<T>> openChannel(const std::string &name, const T &payload)
+{
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        SharedMemoryOptions options;
+        options.latency_stats = true;
+        return std::make_unique<SharedMemory<T>>(name, 1U, options);
+    }
+    else
+    {
+        return std::make_unique<SharedFlatMemory<T>>(name, shm_traits<T>::flat_size(payload));
+    }
+}
+
+/// Send frames from a writer thread to a reader thread, one at a time, and time it.
+/// The reader acknowledges every frame on a second channel so that none is overwritten.
+template <typename T>
+Result measure(const std::string &type, std::size_t bytes)
+{
+    const std::string data_name = "general_inter_p_lib_bench_data";
+    const std::string ack_name = "general_inter_p_lib_bench_ack";
+    const auto iterations = std::clamp(kBytesPerRun / bytes, kMinIterations, kMaxIterations);
+    const auto payload = makePayload<T>(bytes);
+    const auto data = openChannel(data_name, payload);
+    SharedMemory<int> ack(ack_name, sizeof(int));
+    LatencyHistogram round_trip;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::thread reader([&data, &ack, iterations]()
+                       {
+                           T frame{};
+                           for (std::size_t i = 0; i < iterations; ++i)
+                           {
+                               data->read_into(frame);
+                               ack.write(static_cast<int>(i));
+                           } });
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        const auto sent = LatencyHistogram::now();
+        data->write(payload);
+        ack.read();
+        round_trip.record(static_cast<std::uint64_t>(LatencyHistogram::now() - sent));
+    }
+    reader.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    Result result{type, bytes, iterations, elapsed.count(), round_trip.stats(), std::nullopt};
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        result.latency = data->latency();
+    }
+    boost::interprocess::shared_memory_object::remove(data_name.c_str());
+    boost::interprocess::shared_memory_object::remove(ack_name.c_str());
+    return result;
+}
+
+/// Print one result as a JSON object.
+void printJson(const Result &result, bool last)
+{
+    const auto frames_per_second = static_cast<double>(result.iterations) / result.seconds;
+    std::cout << "    {\"type\": \"" << result.type << "\", \"bytes\": " << result.bytes
+              << ", \"iterations\": " << result.iterations
+              << ", \"frames_per_s\": " << frames_per_second
+              << ", \"throughput_mb_s\": " << frames_per_second * static_cast<double>(result.bytes) / 1e6
+              << ", \"round_trip_ns\": {\"p50\": " << result.round_trip.p50 << ", \"p99\": " << result.round_trip.p99
+              << ", \"p999\": " << result.round_trip.p999 << ", \"max\": " << result.round_trip.max << "}";
+    if (result.latency)
+    {
+        std::cout << ", \"latency_ns\": {\"p50\": " << result.latency->p50 << ", \"p99\": " << result.latency->p99
+                  << ", \"p999\": " << result.latency->p999 << ", \"max\": " << result.latency->max << "}";
+    }
+    std::cout << "}" << (last ? "\n" : ",\n");
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const std::size_t max_bytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64U * 1024U * 1024U;
+
+    std::vector<Result> results;
+    results.push_back(measure<int>("int", sizeof(int)));
+    results.push_back(measure<float>("float", sizeof(float)));
+    for (std::size_t bytes = 4U; bytes <= max_bytes; bytes *= 16U)
+    {
+        results.push_back(measure<std::vector<float>>("std::vector<float>", bytes));
+    }
+    for (std::size_t bytes = 4U; bytes <= max_bytes; bytes *= 16U)
+    {
+        // The smallest image holds a single 8 B pixel.
+        results.push_back(measure<Image<std::size_t>>("Image<std::size_t>", std::max(bytes, sizeof(std::size_t))));
+    }
+
+    std::cout << "{\n  \"benchmark\": \"general_inter_p_lib_bench\",\n  \"mode\": \"two_threads\",\n  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        printJson(results[i], i + 1U == results.size());
+    }
+    std::cout << "  ]\n}\n";
+    return 0;
+}
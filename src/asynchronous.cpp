@@ -0,0 +1,176 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "asynchronous.h"
+#include <algorithm>
+#include <utility>
+
+/// Constructor to create the channel and start the publisher thread.
+template <typename T>
+AsyncSharedMemory<T>::AsyncSharedMemory(const std::string &name, std::size_t data_size, const AsyncSharedMemoryOptions &options)
+    : channel_(name, data_size, options.shared_memory),
+      coalescing_(options.coalescing),
+      queue_(std::max<std::size_t>(options.queue_capacity, 1U)),
+      head_(0U),
+      count_(0U),
+      next_ticket_(1U),
+      in_flight_(0U),
+      stop_(false),
+      completed_(0U),
+      published_(0U),
+      coalesced_(0U),
+      failed_(0U),
+      publisher_(&AsyncSharedMemory::run, this)
+{
+}
+
+/// Destructor
+template <typename T>
+AsyncSharedMemory<T>::~AsyncSharedMemory()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    not_empty_.notify_one();
+    publisher_.join();
+}
+
+/// Queue a copy of a frame
+template <typename T>
+typename AsyncSharedMemory<T>::WriteHandle AsyncSharedMemory<T>::write(const T &data)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto &entry = acquireSlot(lock);
+    entry.value = data;
+    return enqueue(entry, lock);
+}
+
+/// Queue a frame by exchanging buffers
+template <typename T>
+typename AsyncSharedMemory<T>::WriteHandle AsyncSharedMemory<T>::write(T &&data)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto &entry = acquireSlot(lock);
+    using std::swap;
+    swap(entry.value, data);
+    return enqueue(entry, lock);
+}
+
+/// Wait until every frame written so far is complete
+template <typename T>
+void AsyncSharedMemory<T>::flush() const
+{
+    std::uint64_t last = 0U;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        last = next_ticket_ - 1U;
+    }
+    waitFor(last);
+}
+
+/// Get a free queue slot
+template <typename T>
+typename AsyncSharedMemory<T>::Entry &AsyncSharedMemory<T>::acquireSlot(std::unique_lock<std::mutex> &lock)
+{
+    if (count_ == queue_.size())
+    {
+        if (coalescing_ == CoalescingPolicy::KeepAll)
+        {
+            not_full_.wait(lock, [this]()
+                           { return count_ < queue_.size(); });
+        }
+        else
+        {
+            head_ = (head_ + 1U) % queue_.size();
+            --count_;
+            coalesced_.fetch_add(1U, std::memory_order_relaxed);
+        }
+    }
+
+    return queue_[(head_ + count_) % queue_.size()];
+}
+
+/// Queue a filled slot
+template <typename T>
+typename AsyncSharedMemory<T>::WriteHandle AsyncSharedMemory<T>::enqueue(Entry &entry, std::unique_lock<std::mutex> &lock)
+{
+    entry.ticket = next_ticket_++;
+    ++count_;
+    const WriteHandle handle(this, entry.ticket);
+    updateCompleted();
+    lock.unlock();
+
+    not_empty_.notify_one();
+    completed_cv_.notify_all();
+    return handle;
+}
+
+/// Body of the publisher thread
+template <typename T>
+void AsyncSharedMemory<T>::run()
+{
+    T pending{};
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        not_empty_.wait(lock, [this]()
+                        { return count_ != 0U || stop_; });
+        if (count_ == 0U)
+        {
+            return;
+        }
+
+        auto &entry = queue_[head_];
+        using std::swap;
+        swap(pending, entry.value);
+        in_flight_ = entry.ticket;
+        head_ = (head_ + 1U) % queue_.size();
+        --count_;
+        lock.unlock();
+        not_full_.notify_one();
+
+        if (channel_.write(pending) == SharedMemory<T>::WriteStatus::Success)
+        {
+            published_.fetch_add(1U, std::memory_order_relaxed);
+        }
+        else
+        {
+            failed_.fetch_add(1U, std::memory_order_relaxed);
+        }
+
+        lock.lock();
+        in_flight_ = 0U;
+        updateCompleted();
+        completed_cv_.notify_all();
+    }
+}
+
+/// Update the completed ticket
+template <typename T>
+void AsyncSharedMemory<T>::updateCompleted()
+{
+    auto oldest_pending = next_ticket_;
+    if (count_ != 0U)
+    {
+        oldest_pending = queue_[head_].ticket;
+    }
+    if (in_flight_ != 0U)
+    {
+        oldest_pending = std::min(oldest_pending, in_flight_);
+    }
+    completed_.store(oldest_pending - 1U, std::memory_order_release);
+}
+
+/// Wait until a ticket is complete
+template <typename T>
+void AsyncSharedMemory<T>::waitFor(std::uint64_t ticket) const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    completed_cv_.wait(lock, [this, ticket]()
+                       { return completed_.load(std::memory_order_acquire) >= ticket; });
+}
+
+// Explicit template instantiation
+template class AsyncSharedMemory<int>;
+template class AsyncSharedMemory<float>;
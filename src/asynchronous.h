@@ -1,131 +1,164 @@
-Making the Code Asynchronous
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the AsyncSharedMemory class.
 
-To make the code asynchronous, you would need to introduce non-blocking operations, such as using threads or asynchronous programming constructs. Here’s an example of how you might modify the write method to perform the write operation asynchronously using a thread:
+#ifndef GENERAL_INTER_P_LIB_SRC_ASYNCHRONOUS_H
+#define GENERAL_INTER_P_LIB_SRC_ASYNCHRONOUS_H
 
-//shared_memory.h
-
-#ifndef INTER_P_COM_INTERFACE_SRC_SHARED_MEMORY_H
-#define INTER_P_COM_INTERFACE_SRC_SHARED_MEMORY_H
-
-#include <boost/interprocess/sync/interprocess_mutex.hpp>
-#include <boost/interprocess/sync/interprocess_condition.hpp>
-#include <boost/interprocess/shared_memory_object.hpp>
-#include <boost/interprocess/mapped_region.hpp>
+#include "shared_memory.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <string>
 #include <thread>
-#include <future>
-#include "image.h" // Include the Image interface
-
-template <typename T>
-class SharedMemory {
-public:
-    SharedMemory(const std::string &name);
-    ~SharedMemory();
-
-    void write(const T &data);
-    T read();
-
-private:
-    struct SharedData {
-        boost::interprocess::interprocess_mutex mutex;        // Mutex for synchronizing access to the shared memory
-        boost::interprocess::interprocess_condition cond_var; // Condition variable for signaling new data
-        bool new_data; // Flag to indicate new data
-        T data;        // Data of type T
-
-        SharedData() : new_data(false) {}
-    };
-
-    std::string name_;                             // Name of the shared memory object
-    boost::interprocess::shared_memory_object shm; // Shared memory object
-    boost::interprocess::mapped_region region;     // Mapped region of the shared memory
-    SharedData *shared_data;                       // Pointer to the shared data in the shared memory
-    std::future<void> write_future_;               // Future for asynchronous write
-};
-
-#endif // INTER_P_COM_INTERFACE_SRC_SHARED_MEMORY_H
-
-
-// shared_memory.cpp
-
-
-#include "shared_memory.h"
+#include <vector>
 
-template <typename T>
-SharedMemory<T>::SharedMemory(const std::string &name)
-    : name_(name), shm(boost::interprocess::open_or_create, name_.c_str(), boost::interprocess::read_write)
+/// @brief What to do when frames are written faster than they can be published.
+///
+enum class CoalescingPolicy
 {
-    // Set the size of the shared memory object
-    shm.truncate(sizeof(SharedData));
-
-    // Map the shared memory into this process
-    region = boost::interprocess::mapped_region(shm, boost::interprocess::read_write);
-
-    // Get the address of the mapped region
-    void *addr = region.get_address();
-
-    // Construct the SharedData object in the shared memory
-    shared_data = new (addr) SharedData();
-}
+    KeepAll,   ///< Publish every frame; write() blocks while the queue is full.
+    KeepLatest ///< Never block; drop the oldest queued frame to make room for the new one.
+};
 
-template <typename T>
-SharedMemory<T>::~SharedMemory()
+/// @brief Options of an AsyncSharedMemory channel, fixed at construction.
+///
+struct AsyncSharedMemoryOptions
 {
-    // Wait for the asynchronous write to complete
-    if (write_future_.valid()) {
-        write_future_.get();
-    }
-
-    // Remove the shared memory object
-    boost::interprocess::shared_memory_object::remove(name_.c_str());
-}
+    std::size_t queue_capacity = 8U;                        ///< Number of frames waiting for the publisher thread.
+    CoalescingPolicy coalescing = CoalescingPolicy::KeepAll; ///< Behaviour when the queue is full.
+    SharedMemoryOptions shared_memory;                      ///< Options of the underlying SharedMemory channel.
+};
 
+/// @brief The AsyncSharedMemory class template publishes frames to a SharedMemory channel
+/// from one long-lived publisher thread.
+///
+/// Capture threads hand a frame over to a bounded in-process queue and return at
+/// once with a WriteHandle; the publisher thread takes the interprocess lock and
+/// wakes the readers. The queue slots are preallocated and frames are exchanged
+/// with std::swap or copy-assigned into a slot, so handing a frame over does not
+/// allocate once the slots have grown to the frame size.
+///
+/// @tparam T template to allow different data types for the shared data, trivially copyable as for SharedMemory.
+///
 template <typename T>
-void SharedMemory<T>::write(const T &data)
+class AsyncSharedMemory
 {
-    // Perform the write operation asynchronously
-    write_future_ = std::async(std::launch::async, [this, data]() {
-        // Lock the mutex before writing to the shared memory
-        boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data->mutex);
-
-        // Write the data to the shared memory
-        shared_data->data = data;
+public:
+    /// @brief Completion handle of one asynchronous write.
+    /// A frame is complete once it was published or dropped by CoalescingPolicy::KeepLatest.
+    /// The handle refers to the channel and must not be used after the channel is destroyed.
+    ///
+    class WriteHandle
+    {
+    public:
+        /// @brief Tell whether the frame is complete, without blocking.
+        bool done() const { return owner_->completed_.load(std::memory_order_acquire) >= ticket_; }
+
+        /// @brief Wait until the frame is complete.
+        void wait() const { owner_->waitFor(ticket_); }
+
+    private:
+        friend class AsyncSharedMemory;
+        WriteHandle(const AsyncSharedMemory *owner, std::uint64_t ticket) : owner_(owner), ticket_(ticket) {}
+
+        const AsyncSharedMemory *owner_; ///< Channel the frame was written to.
+        std::uint64_t ticket_;           ///< Sequence number of the frame, starting at 1.
+    };
 
-        // Set the new_data flag to true
-        shared_data->new_data = true;
+    /// @brief Constructor to create the channel and start the publisher thread.
+    /// @param name The name of the shared memory object.
+    /// @param data_size The size of the data to be stored in shared memory.
+    /// @param options The options of the queue and of the channel.
+    ///
+    AsyncSharedMemory(const std::string &name, std::size_t data_size, const AsyncSharedMemoryOptions &options = {});
 
-        // Notify any waiting threads that new data is available
-        shared_data->cond_var.notify_all();
-    });
-}
+    /// @brief Publish the frames still queued, then stop the publisher thread.
+    ///
+    ~AsyncSharedMemory();
 
-template <typename T>
-T SharedMemory<T>::read()
-{
-    // Lock the mutex before reading from the shared memory
-    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data->mutex);
+    AsyncSharedMemory(const AsyncSharedMemory &) = delete;
+    AsyncSharedMemory &operator=(const AsyncSharedMemory &) = delete;
 
-    // Wait until new data is available
-    while (!shared_data->new_data) {
-        shared_data->cond_var.wait(lock);
-    }
+    /// @brief Queue a copy of a frame for publication.
+    /// The frame is copy-assigned into a recycled queue slot, so its capacity is reused.
+    /// @param data The frame to be published.
+    /// @return A handle to wait for the frame to be complete.
+    ///
+    WriteHandle write(const T &data);
 
-    // Read the data from the shared memory
-    T data = shared_data->data;
+    /// @brief Queue a frame for publication by exchanging buffers instead of copying.
+    /// @param data The frame to be published. It is left holding a recycled buffer.
+    /// @return A handle to wait for the frame to be complete.
+    ///
+    WriteHandle write(T &&data);
 
-    // Reset the new_data flag
-    shared_data->new_data = false;
+    /// @brief Wait until every frame written so far is complete.
+    ///
+    void flush() const;
 
-    return data;
-}
+    /// @brief Get the underlying channel, e.g. to read from it in the same process.
+    /// @return The SharedMemory channel the frames are published to.
+    SharedMemory<T> &channel() { return channel_; }
 
+    /// @brief Get the number of frames published to shared memory.
+    std::uint64_t published() const { return published_.load(std::memory_order_relaxed); }
 
+    /// @brief Get the number of frames dropped by CoalescingPolicy::KeepLatest.
+    std::uint64_t coalesced() const { return coalesced_.load(std::memory_order_relaxed); }
 
-Explanation
-Asynchronous Write: The write method now uses std::async to perform the write operation asynchronously. This allows the method to return immediately, and the actual write operation is performed in a separate thread. 
+    /// @brief Get the number of frames the channel failed to publish.
+    std::uint64_t failed() const { return failed_.load(std::memory_order_relaxed); }
 
-Future for Synchronization: The write_future_ member variable holds the future returned by std::async. The destructor waits for the asynchronous write to complete by calling write_future_.get().
-
-Thread Safety: The write and read methods remain thread-safe due to the use of mutexes and condition variables.
+private:
+    /// @brief A queued frame and its ticket.
+    ///
+    struct Entry
+    {
+        T value{};                ///< The frame.
+        std::uint64_t ticket{0U}; ///< Sequence number of the frame.
+    };
 
-This modification makes the write operation asynchronous, allowing other operations to proceed while the data is being written to shared memory
+    /// @brief Wait for a free queue slot, or drop the oldest frame with CoalescingPolicy::KeepLatest.
+    /// @param lock The lock held on mutex_.
+    /// @return The slot to fill with the frame.
+    Entry &acquireSlot(std::unique_lock<std::mutex> &lock);
+
+    /// @brief Ticket a slot filled after acquireSlot(), then release the lock and wake the publisher thread.
+    /// @param entry The filled slot.
+    /// @param lock The lock held on mutex_.
+    /// @return A handle to wait for the frame to be complete.
+    WriteHandle enqueue(Entry &entry, std::unique_lock<std::mutex> &lock);
+
+    /// @brief Body of the publisher thread.
+    void run();
+
+    /// @brief Update completed_ from the in-flight and queued tickets.
+    /// @pre mutex_ is held.
+    void updateCompleted();
+
+    /// @brief Wait until a ticket is complete.
+    void waitFor(std::uint64_t ticket) const;
+
+    SharedMemory<T> channel_;                   ///< Channel the frames are published to.
+    CoalescingPolicy coalescing_;               ///< Behaviour when the queue is full.
+    std::vector<Entry> queue_;                  ///< Preallocated ring of queued frames.
+    std::size_t head_;                          ///< Index of the oldest queued frame.
+    std::size_t count_;                         ///< Number of queued frames.
+    std::uint64_t next_ticket_;                 ///< Ticket of the next frame to be written.
+    std::uint64_t in_flight_;                   ///< Ticket being published, 0 if none.
+    bool stop_;                                 ///< Set to stop the publisher thread once the queue is empty.
+    std::atomic<std::uint64_t> completed_;      ///< Every ticket up to this one is complete.
+    std::atomic<std::uint64_t> published_;      ///< Number of published frames.
+    std::atomic<std::uint64_t> coalesced_;      ///< Number of dropped frames.
+    std::atomic<std::uint64_t> failed_;         ///< Number of frames that failed to publish.
+    mutable std::mutex mutex_;                  ///< Mutex protecting the queue.
+    std::condition_variable not_empty_;         ///< Signalled when a frame is queued or stop_ is set.
+    std::condition_variable not_full_;          ///< Signalled when a queue slot is freed.
+    mutable std::condition_variable completed_cv_; ///< Signalled when completed_ advances.
+    std::thread publisher_;                     ///< The publisher thread, started last.
+};
 
+#endif // GENERAL_INTER_P_LIB_SRC_ASYNCHRONOUS_H
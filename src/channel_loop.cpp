@@ -0,0 +1,77 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "channel_loop.h"
+#include <utility>
+
+/// Register a suspended coroutine
+void ChannelLoop::watch(Waiter &waiter, std::coroutine_handle<> handle)
+{
+    waiter.handle_ = handle;
+    waiters_.push_back(&waiter);
+}
+
+/// Resume the ready coroutines, waiting for one
+std::size_t ChannelLoop::run_once(std::chrono::steady_clock::duration timeout)
+{
+    return runUntil(std::chrono::steady_clock::now() + timeout);
+}
+
+/// Resume coroutines until none is suspended
+void ChannelLoop::run()
+{
+    while (!waiters_.empty())
+    {
+        runUntil(std::chrono::steady_clock::time_point::max());
+    }
+}
+
+/// Resume the ready coroutines, waiting for one until a deadline
+std::size_t ChannelLoop::runUntil(std::chrono::steady_clock::time_point deadline)
+{
+    while (!waiters_.empty())
+    {
+        for (std::size_t i = 0U; i < waiters_.size();)
+        {
+            auto *waiter = waiters_[i];
+            if (waiter->event_->value() != waiter->seen_ && waiter->check())
+            {
+                ready_.push_back(waiter);
+                waiters_[i] = waiters_.back();
+                waiters_.pop_back();
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        if (!ready_.empty())
+        {
+            // Resumed coroutines may suspend again and call watch(), so resume from a local list.
+            auto ready = std::move(ready_);
+            ready_.clear();
+            for (auto *waiter : ready)
+            {
+                waiter->handle_.resume();
+            }
+            const auto resumed = ready.size();
+            ready.clear();
+            ready_ = std::move(ready);
+            return resumed;
+        }
+
+        events_.clear();
+        expected_.clear();
+        for (const auto *waiter : waiters_)
+        {
+            events_.push_back(waiter->event_);
+            expected_.push_back(waiter->seen_);
+        }
+        if (!FutexEvent::wait_any(events_, expected_, deadline))
+        {
+            return 0U;
+        }
+    }
+    return 0U;
+}
@@ -0,0 +1,99 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the ChannelLoop class.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_CHANNEL_LOOP_H
+#define GENERAL_INTER_P_LIB_SRC_CHANNEL_LOOP_H
+
+#include "futex_event.h"
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief The ChannelLoop class resumes coroutines suspended on shared memory channels,
+/// so one thread can serve many channels instead of parking one thread per blocking read.
+///
+/// Each suspended coroutine is represented by a Waiter watching the futex word of its
+/// channel. When no waiter is ready, the loop parks on all watched words at once with
+/// futex_waitv, so a writer in any process wakes it with the notification it already sends.
+/// A single futex_waitv call takes at most 128 words; beyond that, or without futex_waitv,
+/// the loop polls, see FutexEvent::wait_any(), so larger sets belong on several loops.
+///
+/// A loop is driven by a single thread. Coroutines suspended on it must not be destroyed
+/// before they are resumed.
+///
+class ChannelLoop final
+{
+public:
+    /// @brief Base class of the awaitables suspended on a ChannelLoop.
+    ///
+    class Waiter
+    {
+    public:
+        Waiter(const Waiter &) = delete;
+        Waiter &operator=(const Waiter &) = delete;
+
+        /// @brief Load the futex word, then try to complete the awaited operation.
+        /// Loading the word first guarantees that a write racing with poll() changes it.
+        /// @return true if the operation completed.
+        ///
+        bool check()
+        {
+            seen_ = event_->value();
+            return poll();
+        }
+
+    protected:
+        /// @brief Constructor
+        /// @param event The futex word bumped by the channel on every write.
+        explicit Waiter(const FutexEvent &event) : event_(&event), seen_(0U), handle_() {}
+        virtual ~Waiter() = default;
+
+        /// @brief Try to complete the awaited operation without blocking.
+        /// @return true if the operation completed and the coroutine can be resumed.
+        virtual bool poll() = 0;
+
+    private:
+        friend class ChannelLoop;
+
+        const FutexEvent *event_;         ///< Futex word of the channel.
+        std::uint32_t seen_;              ///< Value of the futex word when last checked.
+        std::coroutine_handle<> handle_;  ///< Coroutine to resume once poll() succeeds.
+    };
+
+    ChannelLoop() = default;
+    ChannelLoop(const ChannelLoop &) = delete;
+    ChannelLoop &operator=(const ChannelLoop &) = delete;
+
+    /// @brief Register a suspended coroutine, called from await_suspend().
+    /// @param waiter The awaitable the coroutine is suspended on, after a failed check().
+    /// @param handle The coroutine to resume.
+    ///
+    void watch(Waiter &waiter, std::coroutine_handle<> handle);
+
+    /// @brief Resume the coroutines whose channel has new data, waiting for one if none is ready.
+    /// @param timeout The maximum time to wait.
+    /// @return The number of coroutines resumed, 0 on timeout or when nothing is watched.
+    ///
+    std::size_t run_once(std::chrono::steady_clock::duration timeout);
+
+    /// @brief Resume coroutines until none is suspended on the loop any more.
+    ///
+    void run();
+
+    /// @brief Get the number of suspended coroutines.
+    std::size_t pending() const { return waiters_.size(); }
+
+private:
+    /// @brief Resume the ready coroutines, waiting for one until a deadline.
+    std::size_t runUntil(std::chrono::steady_clock::time_point deadline);
+
+    std::vector<Waiter *> waiters_;           ///< Suspended coroutines.
+    std::vector<Waiter *> ready_;             ///< Coroutines to resume, reused between calls.
+    std::vector<const FutexEvent *> events_;  ///< Watched futex words, reused between calls.
+    std::vector<std::uint32_t> expected_;     ///< Last seen value of each watched word.
+};
+
+#endif // GENERAL_INTER_P_LIB_SRC_CHANNEL_LOOP_H
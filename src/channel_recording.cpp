@@ -0,0 +1,260 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "channel_recording.h"
+#include "image.h"
+#include "shm_traits.h"
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::uint64_t kRecordingMagic = 0x434552504C49475FULL; ///< "_GILPREC" in little endian.
+constexpr std::uint32_t kRecordingVersion = 1U;                 ///< Bumped on every change of the file layout.
+constexpr std::size_t kRecordingHeaderSize = 64U;               ///< Space reserved for the header.
+
+/// Header at the start of a recording file.
+struct RecordingHeader
+{
+    std::uint64_t magic;         ///< kRecordingMagic.
+    std::uint32_t version;       ///< kRecordingVersion.
+    std::uint32_t reserved;      ///< Padding, always 0.
+    std::uint64_t layout_hash;   ///< layoutHash<T>() of the recorded type.
+    std::uint64_t max_frames;    ///< Number of index entries.
+    std::uint64_t data_capacity; ///< Number of bytes reserved for frames.
+    std::uint64_t frame_count;   ///< Number of recorded frames.
+    std::uint64_t data_size;     ///< Number of bytes of recorded frames.
+};
+static_assert(sizeof(RecordingHeader) <= kRecordingHeaderSize, "Recording header does not fit into its reserved space");
+
+/// Offset of the first frame from the start of the file.
+constexpr std::size_t dataOffset(std::size_t max_frames)
+{
+    return kRecordingHeaderSize + max_frames * sizeof(RecordIndexEntry);
+}
+
+/// Access the header of a mapped recording.
+RecordingHeader *header(const boost::interprocess::mapped_region &region)
+{
+    return static_cast<RecordingHeader *>(region.get_address());
+}
+
+/// Access the index of a mapped recording.
+RecordIndexEntry *index(const boost::interprocess::mapped_region &region)
+{
+    return static_cast<RecordIndexEntry *>(static_cast<void *>(static_cast<unsigned char *>(region.get_address()) + kRecordingHeaderSize));
+}
+} // namespace
+
+/// Constructor to create the recording file.
+template <typename T>
+ChannelRecorder<T>::ChannelRecorder(const std::filesystem::path &path, std::size_t max_frames, std::size_t data_capacity)
+    : path_(path), region_()
+{
+    {
+        std::ofstream create(path, std::ios::binary | std::ios::trunc);
+    }
+    std::filesystem::resize_file(path, dataOffset(max_frames) + data_capacity);
+    const boost::interprocess::file_mapping file(path.c_str(), boost::interprocess::read_write);
+    region_ = boost::interprocess::mapped_region(file, boost::interprocess::read_write);
+
+    *header(region_) = RecordingHeader{kRecordingMagic, kRecordingVersion, 0U, layoutHash<T>(), max_frames, data_capacity, 0U, 0U};
+}
+
+/// Destructor
+template <typename T>
+ChannelRecorder<T>::~ChannelRecorder()
+{
+    const auto used = dataOffset(header(region_)->max_frames) + header(region_)->data_size;
+    region_.flush();
+    region_ = boost::interprocess::mapped_region();
+    std::error_code error;
+    std::filesystem::resize_file(path_, used, error);
+}
+
+/// Append a frame
+template <typename T>
+typename ChannelRecorder<T>::RecordStatus ChannelRecorder<T>::record(const T &frame, std::uint64_t sequence)
+{
+    auto *head = header(region_);
+    const auto size = shm_traits<T>::flat_size(frame);
+    const auto padded = alignUp(size, alignof(std::uint64_t));
+    if (head->frame_count == head->max_frames || head->data_size + padded > head->data_capacity)
+    {
+        return RecordStatus::Full;
+    }
+
+    const auto offset = dataOffset(head->max_frames) + head->data_size;
+    shm_traits<T>::serialize(frame, std::span<unsigned char>(static_cast<unsigned char *>(region_.get_address()) + offset, size));
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch());
+    index(region_)[head->frame_count] = RecordIndexEntry{sequence, now.count(), offset, size};
+    head->data_size += padded;
+    ++head->frame_count;
+    return RecordStatus::Success;
+}
+
+/// Record every write on a channel until a deadline
+template <typename T>
+std::size_t ChannelRecorder<T>::record_from(const SharedMemory<T> &channel, std::chrono::steady_clock::time_point deadline)
+    requires std::is_trivially_copyable_v<T>
+{
+    return recordChannel(channel, deadline);
+}
+
+/// Record every write on a flat channel until a deadline
+template <typename T>
+std::size_t ChannelRecorder<T>::record_from(const SharedFlatMemory<T> &channel, std::chrono::steady_clock::time_point deadline)
+{
+    return recordChannel(channel, deadline);
+}
+
+/// Record the writes of either channel type
+template <typename T>
+template <typename Channel>
+std::size_t ChannelRecorder<T>::recordChannel(const Channel &channel, std::chrono::steady_clock::time_point deadline)
+{
+    std::size_t recorded = 0U;
+    std::uint64_t sequence = channel.sequence();
+    T frame{};
+    while (channel.observe_until(frame, sequence, deadline))
+    {
+        if (record(frame, sequence) == RecordStatus::Full)
+        {
+            break;
+        }
+        ++recorded;
+    }
+    return recorded;
+}
+
+/// Get the number of recorded frames
+template <typename T>
+std::size_t ChannelRecorder<T>::size() const
+{
+    return header(region_)->frame_count;
+}
+
+/// Constructor to map a recording.
+template <typename T>
+ChannelReplayer<T>::ChannelReplayer(const std::filesystem::path &path)
+    : file_(path.c_str(), boost::interprocess::read_only),
+      region_(file_, boost::interprocess::read_only)
+{
+    const auto *head = header(region_);
+    if (region_.get_size() < kRecordingHeaderSize || head->magic != kRecordingMagic || head->version != kRecordingVersion)
+    {
+        throw std::runtime_error("Not a channel recording: " + path.string());
+    }
+    if (head->layout_hash != layoutHash<T>())
+    {
+        throw std::runtime_error("Recording holds another frame type: " + path.string());
+    }
+    if (head->frame_count > head->max_frames || dataOffset(head->max_frames) + head->data_size > region_.get_size())
+    {
+        throw std::runtime_error("Truncated channel recording: " + path.string());
+    }
+}
+
+/// Get the number of recorded frames
+template <typename T>
+std::size_t ChannelReplayer<T>::size() const
+{
+    return header(region_)->frame_count;
+}
+
+/// Get the index entry of a frame
+template <typename T>
+RecordIndexEntry ChannelReplayer<T>::entry(std::size_t position) const
+{
+    if (position >= size())
+    {
+        throw std::out_of_range("Frame index out of range");
+    }
+    return index(region_)[position];
+}
+
+/// Decode a frame
+template <typename T>
+void ChannelReplayer<T>::frame(std::size_t position, T &out) const
+{
+    const auto record = entry(position);
+    if (record.offset + record.size > region_.get_size())
+    {
+        throw std::runtime_error("Corrupted channel recording");
+    }
+    const auto *base = static_cast<const unsigned char *>(region_.get_address());
+    shm_traits<T>::deserialize(std::span<const unsigned char>(base + record.offset, record.size), out);
+}
+
+/// Republish every frame on a channel
+template <typename T>
+std::size_t ChannelReplayer<T>::replay(SharedMemory<T> &channel, double speed) const
+    requires std::is_trivially_copyable_v<T>
+{
+    return replayOn(channel, speed);
+}
+
+/// Republish every frame on a flat channel
+template <typename T>
+std::size_t ChannelReplayer<T>::replay(SharedFlatMemory<T> &channel, double speed) const
+{
+    return replayOn(channel, speed);
+}
+
+/// Republish on either channel type
+template <typename T>
+template <typename Channel>
+std::size_t ChannelReplayer<T>::replayOn(Channel &channel, double speed) const
+{
+    std::size_t published = 0U;
+    if (size() == 0U)
+    {
+        return published;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto first = entry(0U).timestamp_ns;
+    T buffer{};
+    for (std::size_t i = 0U; i < size(); ++i)
+    {
+        frame(i, buffer);
+        if (speed > 0.0)
+        {
+            const auto elapsed = static_cast<double>(entry(i).timestamp_ns - first) / speed;
+            std::this_thread::sleep_until(start + std::chrono::nanoseconds(static_cast<std::int64_t>(elapsed)));
+        }
+        if (channel.write(buffer) == Channel::WriteStatus::Success)
+        {
+            ++published;
+        }
+    }
+    return published;
+}
+
+/// Tell whether a file is a recording of T
+template <typename T>
+bool ChannelReplayer<T>::matches(const std::filesystem::path &path)
+{
+    try
+    {
+        const ChannelReplayer<T> replayer(path);
+        return true;
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+}
+
+// Explicit template instantiation
+template class ChannelRecorder<int>;
+template class ChannelRecorder<float>;
+template class ChannelRecorder<Image<std::size_t>>;
+template class ChannelRecorder<std::vector<float>>;
+template class ChannelReplayer<int>;
+template class ChannelReplayer<float>;
+template class ChannelReplayer<Image<std::size_t>>;
+template class ChannelReplayer<std::vector<float>>;
@@ -0,0 +1,157 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the ChannelRecorder and ChannelReplayer classes.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_CHANNEL_RECORDING_H
+#define GENERAL_INTER_P_LIB_SRC_CHANNEL_RECORDING_H
+
+#include "shared_flat_memory.h"
+#include "shared_memory.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <type_traits>
+
+/// @brief Index entry of one recorded frame.
+///
+struct RecordIndexEntry
+{
+    std::uint64_t sequence;     ///< Sequence number of the write on the channel.
+    std::int64_t timestamp_ns;  ///< Steady clock time of the recording, in nanoseconds.
+    std::uint64_t offset;       ///< Offset of the encoded frame from the start of the file.
+    std::uint64_t size;         ///< Size of the encoded frame in bytes.
+};
+
+/// @brief The ChannelRecorder class template appends the frames of a SharedMemory or
+/// SharedFlatMemory channel to a memory-mapped file, with a sequence number and timestamp index.
+///
+/// The file holds a header, an index of max_frames fixed-size entries, then the frames in
+/// their shm_traits<T> flat layout. It is sized and mapped once at construction, so recording
+/// a frame is a copy into the mapping, and is truncated to the recorded data on destruction.
+///
+/// @tparam T template to allow different data types, as for SharedMemory.
+///
+template <typename T>
+class ChannelRecorder
+{
+public:
+    /// @brief Enum to represent the status of a record operation.
+    ///
+    enum class RecordStatus
+    {
+        Success, ///< The frame was appended.
+        Full     ///< The index or the data area of the file is exhausted.
+    };
+
+    /// @brief Constructor to create the recording file, replacing any existing one.
+    /// @param path The path of the recording.
+    /// @param max_frames The number of index entries to reserve.
+    /// @param data_capacity The number of bytes to reserve for the encoded frames.
+    /// @throws boost::interprocess::interprocess_exception or std::filesystem::filesystem_error if the file cannot be created.
+    ///
+    ChannelRecorder(const std::filesystem::path &path, std::size_t max_frames, std::size_t data_capacity);
+
+    /// @brief Destructor to unmap the file and truncate it to the recorded data.
+    ///
+    ~ChannelRecorder();
+
+    ChannelRecorder(const ChannelRecorder &) = delete;
+    ChannelRecorder &operator=(const ChannelRecorder &) = delete;
+
+    /// @brief Append a frame, timestamped now.
+    /// @param frame The frame to be recorded.
+    /// @param sequence The sequence number of the frame, e.g. from SharedMemory::observe_until().
+    /// @return RecordStatus::Full if the file has no room left.
+    ///
+    RecordStatus record(const T &frame, std::uint64_t sequence);
+
+    /// @brief Record every write on a channel until a deadline, without consuming the data.
+    /// The value already on the channel is skipped, recording starts with the next write.
+    /// @param channel The channel to record.
+    /// @param deadline The point in time at which to stop.
+    /// @return The number of frames recorded.
+    ///
+    std::size_t record_from(const SharedMemory<T> &channel, std::chrono::steady_clock::time_point deadline)
+        requires std::is_trivially_copyable_v<T>;
+
+    /// @brief Record every write on a flat channel until a deadline, without consuming the data.
+    /// The value already on the channel is skipped, recording starts with the next write.
+    /// @param channel The channel to record.
+    /// @param deadline The point in time at which to stop.
+    /// @return The number of frames recorded.
+    ///
+    std::size_t record_from(const SharedFlatMemory<T> &channel, std::chrono::steady_clock::time_point deadline);
+
+    /// @brief Get the number of frames recorded so far.
+    std::size_t size() const;
+
+private:
+    /// @brief Record the writes of either channel type, see record_from().
+    template <typename Channel>
+    std::size_t recordChannel(const Channel &channel, std::chrono::steady_clock::time_point deadline);
+
+    std::filesystem::path path_;                 ///< The path of the recording.
+    boost::interprocess::mapped_region region_; ///< Mapping of the whole file.
+};
+
+/// @brief The ChannelReplayer class template reads a recording made by ChannelRecorder and
+/// republishes its frames on a SharedMemory or SharedFlatMemory channel.
+///
+/// @tparam T template to allow different data types, as for SharedMemory.
+///
+template <typename T>
+class ChannelReplayer
+{
+public:
+    /// @brief Constructor to map a recording.
+    /// @param path The path of the recording.
+    /// @throws std::runtime_error if the file is not a recording of T.
+    ///
+    explicit ChannelReplayer(const std::filesystem::path &path);
+
+    /// @brief Get the number of recorded frames.
+    std::size_t size() const;
+
+    /// @brief Get the index entry of a frame.
+    /// @param index The position of the frame in the recording.
+    RecordIndexEntry entry(std::size_t index) const;
+
+    /// @brief Decode a frame.
+    /// @param index The position of the frame in the recording.
+    /// @param out The object receiving the frame, whose capacity is reused.
+    ///
+    void frame(std::size_t index, T &out) const;
+
+    /// @brief Republish every frame on a channel.
+    /// @param channel The channel to publish to.
+    /// @param speed 1 for the original pace, above 1 to accelerate, 0 or less to publish as fast as possible.
+    /// @return The number of frames published.
+    ///
+    std::size_t replay(SharedMemory<T> &channel, double speed = 1.0) const
+        requires std::is_trivially_copyable_v<T>;
+
+    /// @brief Republish every frame on a flat channel.
+    /// @param channel The channel to publish to.
+    /// @param speed 1 for the original pace, above 1 to accelerate, 0 or less to publish as fast as possible.
+    /// @return The number of frames published.
+    ///
+    std::size_t replay(SharedFlatMemory<T> &channel, double speed = 1.0) const;
+
+    /// @brief Tell whether a file is a recording of T, without throwing.
+    /// @param path The path of the file.
+    static bool matches(const std::filesystem::path &path);
+
+private:
+    /// @brief Republish on either channel type, see replay().
+    template <typename Channel>
+    std::size_t replayOn(Channel &channel, double speed) const;
+
+    boost::interprocess::file_mapping file_;    ///< The recording file.
+    boost::interprocess::mapped_region region_; ///< Read-only mapping of the whole file.
+};
+
+#endif // GENERAL_INTER_P_LIB_SRC_CHANNEL_RECORDING_H
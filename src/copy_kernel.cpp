@@ -0,0 +1,81 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "copy_kernel.h"
+#include <cstdint>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+#if defined(__x86_64__)
+/// Copy with 32-byte non-temporal stores, compiled for AVX2 whatever the flags of the build.
+__attribute__((target("avx2"))) void streamingCopyAvx2(void *destination, const void *source, std::size_t size)
+{
+    auto *out = static_cast<unsigned char *>(destination);
+    const auto *in = static_cast<const unsigned char *>(source);
+
+    // Streaming stores need an aligned destination: copy the head up to the next 32-byte boundary.
+    const auto misalignment = reinterpret_cast<std::uintptr_t>(out) % sizeof(__m256i);
+    const auto head = std::min(size, misalignment == 0U ? std::size_t{0U} : sizeof(__m256i) - misalignment);
+    std::memcpy(out, in, head);
+    out += head;
+    in += head;
+    size -= head;
+
+    // Four vectors per iteration keep the write-combining buffers busy.
+    constexpr std::size_t kBlock = 4U * sizeof(__m256i);
+    for (; size >= kBlock; size -= kBlock, in += kBlock, out += kBlock)
+    {
+        const auto *source_vectors = static_cast<const __m256i *>(static_cast<const void *>(in));
+        auto *destination_vectors = static_cast<__m256i *>(static_cast<void *>(out));
+        const __m256i a = _mm256_loadu_si256(source_vectors);
+        const __m256i b = _mm256_loadu_si256(source_vectors + 1);
+        const __m256i c = _mm256_loadu_si256(source_vectors + 2);
+        const __m256i d = _mm256_loadu_si256(source_vectors + 3);
+        _mm256_stream_si256(destination_vectors, a);
+        _mm256_stream_si256(destination_vectors + 1, b);
+        _mm256_stream_si256(destination_vectors + 2, c);
+        _mm256_stream_si256(destination_vectors + 3, d);
+    }
+    // Order the weakly ordered streaming stores before the release of the channel mutex.
+    _mm_sfence();
+    std::memcpy(out, in, size);
+}
+#endif
+
+/// Detect the kernel supported by the CPU.
+CopyKernel detectStreamingCopyKernel()
+{
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return CopyKernel::StreamingAvx2;
+    }
+#endif
+    return CopyKernel::Memcpy;
+}
+} // namespace
+
+/// Get the fastest kernel for large copies
+CopyKernel streamingCopyKernel()
+{
+    static const CopyKernel kernel = detectStreamingCopyKernel();
+    return kernel;
+}
+
+/// Copy bytes with a given kernel
+void copyBytes(void *destination, const void *source, std::size_t size, CopyKernel kernel)
+{
+#if defined(__x86_64__)
+    if (kernel == CopyKernel::StreamingAvx2 && streamingCopyKernel() == CopyKernel::StreamingAvx2)
+    {
+        streamingCopyAvx2(destination, source, size);
+        return;
+    }
+#else
+    static_cast<void>(kernel);
+#endif
+    std::memcpy(destination, source, size);
+}
@@ -0,0 +1,96 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the payload copy kernels.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_COPY_KERNEL_H
+#define GENERAL_INTER_P_LIB_SRC_COPY_KERNEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/// @brief Payload size from which copies into shared memory use streaming stores.
+/// Below it the destination is likely to be read back soon and a cached memcpy is faster.
+///
+inline constexpr std::size_t kStreamingCopyThreshold = 1024U * 1024U;
+
+/// @brief Implementation of a bulk copy.
+///
+enum class CopyKernel
+{
+    Memcpy,       ///< std::memcpy, the destination goes through the cache.
+    StreamingAvx2 ///< 32-byte AVX2 non-temporal stores that bypass the cache, x86-64 only.
+};
+
+/// @brief Get the fastest kernel for copies of at least kStreamingCopyThreshold bytes,
+/// detected once from the CPU at runtime.
+///
+CopyKernel streamingCopyKernel();
+
+/// @brief Copy bytes with a given kernel.
+/// Falls back to Memcpy when the kernel is not supported by the CPU.
+///
+/// @param destination The destination, must not overlap the source.
+/// @param source The source.
+/// @param size The number of bytes to copy.
+/// @param kernel The kernel to use.
+///
+void copyBytes(void *destination, const void *source, std::size_t size, CopyKernel kernel);
+
+/// @brief Copy bytes, with streaming stores from kStreamingCopyThreshold bytes on when the CPU has them.
+///
+/// @param destination The destination, must not overlap the source.
+/// @param source The source.
+/// @param size The number of bytes to copy.
+///
+inline void copyBytes(void *destination, const void *source, std::size_t size)
+{
+    if (size < kStreamingCopyThreshold)
+    {
+        std::memcpy(destination, source, size);
+    }
+    else
+    {
+        copyBytes(destination, source, size, streamingCopyKernel());
+    }
+}
+
+/// @brief Copy an array of elements, as bytes if they are trivially copyable.
+///
+template <typename T>
+void copyElements(const T *source, std::size_t count, T *destination)
+{
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        if (count != 0U)
+        {
+            copyBytes(destination, source, count * sizeof(T));
+        }
+    }
+    else
+    {
+        std::copy(source, source + count, destination);
+    }
+}
+
+/// @brief Copy a trivially copyable payload, choosing the strategy at compile time from its size.
+///
+/// The payload is copied with std::memcpy, or with copyBytes() when it is at least
+/// kStreamingCopyThreshold bytes.
+///
+template <typename T>
+void copyPayload(const T &source, T &destination)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "copyPayload copies the object representation");
+    if constexpr (sizeof(T) >= kStreamingCopyThreshold)
+    {
+        copyBytes(&destination, &source, sizeof(T));
+    }
+    else
+    {
+        std::memcpy(&destination, &source, sizeof(T));
+    }
+}
+
+#endif // GENERAL_INTER_P_LIB_SRC_COPY_KERNEL_H
@@ -0,0 +1,228 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "eventfd_bridge.h"
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+/// Build the abstract unix socket address of a channel, e.g. "\0general_inter_p_lib/name".
+socklen_t socketAddress(const std::string &name, sockaddr_un &address)
+{
+    const std::string path = "general_inter_p_lib/" + name;
+    if (path.size() + 1U > sizeof(address.sun_path))
+    {
+        throw std::runtime_error("Channel name too long for an eventfd bridge: " + name);
+    }
+    address = sockaddr_un{};
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path + 1, path.data(), path.size());
+    return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1U + path.size());
+}
+
+/// Throw a std::runtime_error carrying errno.
+[[noreturn]] void throwErrno(const std::string &what)
+{
+    throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+} // namespace
+
+/// Constructor to start accepting subscribers
+EventFdPublisher::EventFdPublisher(const std::string &name)
+    : listener_(socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0))
+{
+    fds_.push_back(pollfd{listener_, POLLIN, 0});
+    if (listener_ == -1)
+    {
+        throwErrno("Cannot create eventfd bridge socket");
+    }
+    sockaddr_un address{};
+    const auto length = socketAddress(name, address);
+    if (bind(listener_, static_cast<sockaddr *>(static_cast<void *>(&address)), length) == -1 || listen(listener_, SOMAXCONN) == -1)
+    {
+        const int error = errno;
+        close(listener_);
+        errno = error;
+        throwErrno("Cannot publish eventfd bridge for " + name);
+    }
+}
+
+/// Destructor
+EventFdPublisher::~EventFdPublisher()
+{
+    for (const auto &connection : connections_)
+    {
+        close(connection.socket);
+        if (connection.event != -1)
+        {
+            close(connection.event);
+        }
+    }
+    close(listener_);
+}
+
+/// Signal every subscriber
+void EventFdPublisher::notify()
+{
+    update();
+    const std::uint64_t one = 1U;
+    for (const auto &connection : connections_)
+    {
+        if (connection.event != -1)
+        {
+            // Only fails with EAGAIN once the counter is saturated, which still leaves it readable.
+            [[maybe_unused]] const auto written = write(connection.event, &one, sizeof(one));
+        }
+    }
+}
+
+/// Get the number of subscribers
+std::size_t EventFdPublisher::subscribers() const
+{
+    std::size_t count = 0U;
+    for (const auto &connection : connections_)
+    {
+        count += connection.event != -1 ? 1U : 0U;
+    }
+    return count;
+}
+
+/// Accept new subscribers and drop closed ones
+void EventFdPublisher::update()
+{
+    // fds_ mirrors connections_ after the listener, so steady-state updates do not allocate.
+    if (poll(fds_.data(), fds_.size(), 0) <= 0)
+    {
+        return;
+    }
+
+    for (std::size_t i = connections_.size(); i-- > 0U;)
+    {
+        const auto revents = fds_[i + 1U].revents;
+        if (revents == 0)
+        {
+            continue;
+        }
+        bool closed = (revents & (POLLHUP | POLLERR)) != 0;
+        if (!closed && (revents & POLLIN) != 0)
+        {
+            closed = !receive(connections_[i]);
+        }
+        if (closed)
+        {
+            close(connections_[i].socket);
+            if (connections_[i].event != -1)
+            {
+                close(connections_[i].event);
+            }
+            connections_[i] = connections_.back();
+            connections_.pop_back();
+            fds_[i + 1U] = fds_.back();
+            fds_.pop_back();
+        }
+    }
+
+    if ((fds_[0].revents & POLLIN) != 0)
+    {
+        int socket = -1;
+        while ((socket = accept4(listener_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) != -1)
+        {
+            Connection connection{socket, -1};
+            // A subscriber sends its eventfd before its constructor returns, so receive it right away.
+            if (!receive(connection))
+            {
+                close(socket);
+                continue;
+            }
+            connections_.push_back(connection);
+            fds_.push_back(pollfd{socket, POLLIN, 0});
+        }
+    }
+}
+
+/// Receive the eventfd of a subscriber
+bool EventFdPublisher::receive(Connection &connection)
+{
+    char byte = 0;
+    iovec data{&byte, sizeof(byte)};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr message{};
+    message.msg_iov = &data;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    const auto received = recvmsg(connection.socket, &message, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+    const auto *header = CMSG_FIRSTHDR(&message);
+    if (received > 0 && connection.event == -1 && header != nullptr && header->cmsg_type == SCM_RIGHTS)
+    {
+        std::memcpy(&connection.event, CMSG_DATA(header), sizeof(int));
+    }
+    return received > 0 || (received == -1 && errno == EAGAIN);
+}
+
+/// Constructor to subscribe to a channel
+EventFdSubscriber::EventFdSubscriber(const std::string &name)
+    : event_(eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC)),
+      socket_(socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0))
+{
+    if (event_ == -1 || socket_ == -1)
+    {
+        const int error = errno;
+        close(event_);
+        close(socket_);
+        errno = error;
+        throwErrno("Cannot create eventfd subscriber");
+    }
+
+    sockaddr_un address{};
+    const auto length = socketAddress(name, address);
+    char byte = 0;
+    iovec data{&byte, sizeof(byte)};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr message{};
+    message.msg_iov = &data;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    auto *header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(header), &event_, sizeof(int));
+
+    if (connect(socket_, static_cast<sockaddr *>(static_cast<void *>(&address)), length) == -1 ||
+        sendmsg(socket_, &message, MSG_NOSIGNAL) == -1)
+    {
+        const int error = errno;
+        close(event_);
+        close(socket_);
+        errno = error;
+        throwErrno("No eventfd bridge published for " + name);
+    }
+}
+
+/// Destructor
+EventFdSubscriber::~EventFdSubscriber()
+{
+    close(socket_);
+    close(event_);
+}
+
+/// Reset the eventfd
+std::uint64_t EventFdSubscriber::consume()
+{
+    std::uint64_t count = 0U;
+    if (read(event_, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count)))
+    {
+        return 0U;
+    }
+    return count;
+}
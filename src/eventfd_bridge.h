@@ -0,0 +1,101 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the EventFdPublisher and EventFdSubscriber classes.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_EVENTFD_BRIDGE_H
+#define GENERAL_INTER_P_LIB_SRC_EVENTFD_BRIDGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <poll.h>
+
+/// @brief The EventFdPublisher class signals the eventfds of the subscribers of a channel.
+///
+/// It listens on an abstract unix socket derived from the channel name. Each
+/// EventFdSubscriber connects to it and passes its eventfd with SCM_RIGHTS. Subscriptions
+/// are picked up and closed subscribers dropped by notify() itself, with a single
+/// non-blocking poll(), so no helper thread is needed. Linux only.
+///
+class EventFdPublisher final
+{
+public:
+    /// @brief Constructor to start accepting subscribers.
+    /// @param name The name of the channel.
+    /// @throws std::runtime_error if the socket cannot be created or another publisher serves the channel.
+    ///
+    explicit EventFdPublisher(const std::string &name);
+
+    /// @brief Destructor to close the socket and the subscribers' eventfds.
+    ///
+    ~EventFdPublisher();
+
+    EventFdPublisher(const EventFdPublisher &) = delete;
+    EventFdPublisher &operator=(const EventFdPublisher &) = delete;
+
+    /// @brief Signal the eventfd of every subscriber, after accepting new ones.
+    ///
+    void notify();
+
+    /// @brief Get the number of subscribers known after the last notify().
+    std::size_t subscribers() const;
+
+private:
+    /// @brief A subscriber connection and the eventfd it passed.
+    ///
+    struct Connection
+    {
+        int socket; ///< Connection to the subscriber.
+        int event;  ///< Eventfd of the subscriber, -1 until received.
+    };
+
+    /// @brief Accept new subscribers, receive their eventfds and drop closed connections.
+    void update();
+
+    /// @brief Receive the eventfd a subscriber sent, without blocking.
+    /// @return false if the connection was closed.
+    static bool receive(Connection &connection);
+
+    int listener_;                        ///< Listening socket.
+    std::vector<Connection> connections_; ///< Connected subscribers.
+    std::vector<pollfd> fds_;             ///< The listener, then one entry per connection, polled by update().
+};
+
+/// @brief The EventFdSubscriber class provides an eventfd that becomes readable whenever
+/// the writer of a channel publishes, so shared memory channels can be waited on with
+/// epoll or Boost.Asio alongside sockets.
+///
+/// When the eventfd is readable, call consume() and then read the channel without blocking.
+/// Writes started after the constructor returned are always signalled. Linux only.
+///
+class EventFdSubscriber final
+{
+public:
+    /// @brief Constructor to subscribe to the publisher of a channel.
+    /// @param name The name of the channel.
+    /// @throws std::runtime_error if no publisher serves the channel.
+    ///
+    explicit EventFdSubscriber(const std::string &name);
+
+    /// @brief Destructor to unsubscribe; the publisher notices on its next notify().
+    ///
+    ~EventFdSubscriber();
+
+    EventFdSubscriber(const EventFdSubscriber &) = delete;
+    EventFdSubscriber &operator=(const EventFdSubscriber &) = delete;
+
+    /// @brief Get the eventfd to register with epoll, readable (EPOLLIN) after a publish.
+    int fd() const { return event_; }
+
+    /// @brief Reset the eventfd without blocking.
+    /// @return The number of publishes since the last call, 0 if none.
+    ///
+    std::uint64_t consume();
+
+private:
+    int event_;  ///< Non-blocking eventfd signalled by the publisher.
+    int socket_; ///< Connection to the publisher, kept open while subscribed.
+};
+
+#endif // GENERAL_INTER_P_LIB_SRC_EVENTFD_BRIDGE_H
@@ -0,0 +1,185 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "futex_event.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// futex_waitv needs Linux 5.16 headers for both the system call number and struct futex_waitv.
+#if defined(__linux__) && defined(SYS_futex_waitv) && defined(FUTEX_WAITV_MAX)
+#define GENERAL_INTER_P_LIB_HAS_FUTEX_WAITV 1
+#endif
+
+namespace
+{
+/// Hint the CPU that the caller is spinning.
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/// Tell whether any word differs from its expected value.
+bool anyChanged(std::span<const FutexEvent *const> events, std::span<const std::uint32_t> expected)
+{
+    for (std::size_t i = 0U; i < events.size(); ++i)
+    {
+        if (events[i]->value() != expected[i])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+/// Wait until the futex word changes
+void FutexEvent::wait(std::uint32_t expected, std::uint32_t spin_count) const
+{
+    for (std::uint32_t i = 0U; i < spin_count; ++i)
+    {
+        if (word_.load(std::memory_order_acquire) != expected)
+        {
+            return;
+        }
+        cpuRelax();
+    }
+
+    // Sequentially consistent so that the notifier either sees this waiter or the
+    // waiter sees the bumped word.
+    waiters_.fetch_add(1U, std::memory_order_seq_cst);
+    while (word_.load(std::memory_order_seq_cst) == expected)
+    {
+#if defined(__linux__)
+        // Shared futex: the word may be mapped at different addresses in different processes.
+        syscall(SYS_futex, &word_, FUTEX_WAIT, expected, nullptr, nullptr, 0);
+#else
+        std::this_thread::yield();
+#endif
+    }
+    waiters_.fetch_sub(1U, std::memory_order_relaxed);
+}
+
+/// Wait until the futex word changes or the deadline passes
+bool FutexEvent::wait_until(std::uint32_t expected, std::uint32_t spin_count, std::chrono::steady_clock::time_point deadline) const
+{
+    for (std::uint32_t i = 0U; i < spin_count; ++i)
+    {
+        if (word_.load(std::memory_order_acquire) != expected)
+        {
+            return true;
+        }
+        cpuRelax();
+    }
+
+    waiters_.fetch_add(1U, std::memory_order_seq_cst);
+    bool changed = true;
+    while (word_.load(std::memory_order_seq_cst) == expected)
+    {
+        const auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::steady_clock::duration::zero())
+        {
+            changed = false;
+            break;
+        }
+#if defined(__linux__)
+        // FUTEX_WAIT takes a relative timeout measured against CLOCK_MONOTONIC.
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+        const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining - seconds);
+        timespec timeout{};
+        timeout.tv_sec = static_cast<time_t>(seconds.count());
+        timeout.tv_nsec = static_cast<long>(nanoseconds.count());
+        syscall(SYS_futex, &word_, FUTEX_WAIT, expected, &timeout, nullptr, 0);
+#else
+        std::this_thread::yield();
+#endif
+    }
+    waiters_.fetch_sub(1U, std::memory_order_relaxed);
+    return changed;
+}
+
+/// Wait until any of several futex words changes or the deadline passes
+bool FutexEvent::wait_any(std::span<const FutexEvent *const> events, std::span<const std::uint32_t> expected,
+                          std::chrono::steady_clock::time_point deadline)
+{
+    for (const auto *event : events)
+    {
+        event->waiters_.fetch_add(1U, std::memory_order_seq_cst);
+    }
+
+    bool changed = true;
+#if defined(GENERAL_INTER_P_LIB_HAS_FUTEX_WAITV)
+    bool vectored = events.size() <= FUTEX_WAITV_MAX;
+    std::array<futex_waitv, FUTEX_WAITV_MAX> waiters{};
+    for (std::size_t i = 0U; vectored && i < events.size(); ++i)
+    {
+        waiters[i].val = expected[i];
+        waiters[i].uaddr = reinterpret_cast<std::uintptr_t>(&events[i]->word_);
+        waiters[i].flags = FUTEX_32;
+    }
+#endif
+    while (!anyChanged(events, expected))
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+        {
+            changed = false;
+            break;
+        }
+#if defined(GENERAL_INTER_P_LIB_HAS_FUTEX_WAITV)
+        if (vectored)
+        {
+            // futex_waitv takes an absolute timeout; steady_clock is CLOCK_MONOTONIC on Linux.
+            timespec timeout{};
+            const bool forever = deadline == std::chrono::steady_clock::time_point::max();
+            if (!forever)
+            {
+                const auto since_epoch = deadline.time_since_epoch();
+                const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+                timeout.tv_sec = static_cast<time_t>(seconds.count());
+                timeout.tv_nsec = static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch - seconds).count());
+            }
+            if (syscall(SYS_futex_waitv, waiters.data(), static_cast<unsigned>(events.size()), 0U,
+                        forever ? nullptr : &timeout, CLOCK_MONOTONIC) == -1 &&
+                errno == ENOSYS)
+            {
+                vectored = false;
+            }
+            continue;
+        }
+#endif
+        // No vectored wait available, or more words than one call takes: poll the words.
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(deadline - now, std::chrono::microseconds(100)));
+    }
+
+    for (const auto *event : events)
+    {
+        event->waiters_.fetch_sub(1U, std::memory_order_relaxed);
+    }
+    return changed;
+}
+
+/// Wake every waiter
+void FutexEvent::notify_all()
+{
+    word_.fetch_add(1U, std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_seq_cst) != 0U)
+    {
+#if defined(__linux__)
+        syscall(SYS_futex, &word_, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+    }
+}
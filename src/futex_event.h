@@ -0,0 +1,70 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the FutexEvent class.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_FUTEX_EVENT_H
+#define GENERAL_INTER_P_LIB_SRC_FUTEX_EVENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <span>
+
+/// @brief The FutexEvent class is a wait/notify primitive meant to be placed in
+/// shared memory, built on a Linux futex word.
+///
+/// Every notification bumps the word. A waiter spins for a configurable number of
+/// iterations before parking in the kernel, and the notifier only issues the wake
+/// system call when a waiter is registered.
+///
+class FutexEvent final
+{
+public:
+    FutexEvent() = default;
+    FutexEvent(const FutexEvent &) = delete;
+    FutexEvent &operator=(const FutexEvent &) = delete;
+
+    /// @brief Get the current value of the futex word.
+    /// Load it before checking the awaited condition and pass it to wait().
+    /// @return The number of notifications so far, modulo 2^32.
+    ///
+    std::uint32_t value() const { return word_.load(std::memory_order_acquire); }
+
+    /// @brief Wait until the futex word differs from a previously loaded value.
+    /// @param expected The value returned by value() before checking the condition.
+    /// @param spin_count The number of iterations to spin before parking in the kernel.
+    ///
+    void wait(std::uint32_t expected, std::uint32_t spin_count) const;
+
+    /// @brief Wait until the futex word differs from a previously loaded value or a deadline passes.
+    /// @param expected The value returned by value() before checking the condition.
+    /// @param spin_count The number of iterations to spin before parking in the kernel.
+    /// @param deadline The point in time after which to give up.
+    /// @return false if the deadline passed with the word still equal to expected.
+    ///
+    bool wait_until(std::uint32_t expected, std::uint32_t spin_count, std::chrono::steady_clock::time_point deadline) const;
+
+    /// @brief Wait until any of several futex words differs from its previously loaded value or a deadline passes.
+    /// Up to 128 words are parked on with a single futex_waitv call. Larger sets, kernels before 5.16 and
+    /// builds against older kernel headers fall back to polling every 100 us, so a thread watching hundreds
+    /// of channels should split them into groups of at most 128, e.g. one ChannelLoop per group.
+    /// @param events The events to watch.
+    /// @param expected The values returned by value() before checking the conditions, one per event.
+    /// @param deadline The point in time after which to give up, time_point::max() to wait forever.
+    /// @return false if the deadline passed with every word still equal to its expected value.
+    ///
+    static bool wait_any(std::span<const FutexEvent *const> events, std::span<const std::uint32_t> expected,
+                         std::chrono::steady_clock::time_point deadline);
+
+    /// @brief Wake every waiter, skipping the system call if nobody is parked.
+    ///
+    void notify_all();
+
+private:
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Futex word must be lock-free to be shared between processes");
+
+    std::atomic<std::uint32_t> word_{0U};            ///< Futex word, bumped on every notification.
+    mutable std::atomic<std::uint32_t> waiters_{0U}; ///< Number of waiters parked or about to park.
+};
+
+#endif // GENERAL_INTER_P_LIB_SRC_FUTEX_EVENT_H
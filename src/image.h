@@ -74,6 +74,24 @@ public:
     /// @return A span to the image data.
     std::span<const T> readData() const { return std::span<const T>(data_); }
 
+    /// @brief Function to access the image data for writing in place.
+    /// @return A span to the image data.
+    std::span<T> data() { return std::span<T>(data_); }
+
+    /// @brief Change the shape of the image, reusing the capacity of the pixel buffer.
+    /// The pixels kept from the previous shape keep their values, the added ones are value-initialized.
+    /// @param width The new width of the image.
+    /// @param height The new height of the image.
+    /// @param num_channels The new number of channels of the image.
+    ///
+    void reshape(std::size_t width, std::size_t height, std::size_t num_channels = 1)
+    {
+        width_ = width;
+        height_ = height;
+        num_channels_ = num_channels;
+        data_.resize(width_ * height_ * num_channels_);
+    }
+
     /// @brief Setter and getter pixel value at a given position in the image.
     /// Converts a 3D pixel into 1D index.
     /// @param pixel_position_along_width The horizontal position of the pixel.
@@ -111,5 +129,76 @@ private:
     std::size_t num_channels_;
     std::vector<T> data_;
 };
+
+/// @brief The ImageView class template is a non-owning view of an image whose pixels
+/// live elsewhere, e.g. directly in a shared memory segment.
+/// The pixels are laid out as in Image: channel after channel, each row-major.
+///
+/// @tparam T template for the pixel type, const-qualified for a read-only view.
+///
+/// @pre data.size() >= width * height * num_channels.
+///
+template <typename T>
+class ImageView final
+{
+public:
+    /// Construct a view over existing pixel data.
+    ImageView(std::span<T> data, std::size_t width, std::size_t height, std::size_t num_channels = 1)
+        : width_(width), height_(height), num_channels_(num_channels), data_(data)
+    {
+        assert(data.size() >= width * height * num_channels && "Pixel data is smaller than the image");
+    }
+
+    /// @brief Get the size of the image.
+    /// @return The size of the image.
+    std::size_t size() const { return width_ * height_; }
+
+    /// @brief Get the width of the image.
+    /// @return The width of the image.
+    std::size_t width() const { return width_; }
+
+    /// @brief Get the height of the image.
+    /// @return The height of the image.
+    std::size_t height() const { return height_; }
+
+    /// @brief Get the number of channels in the image.
+    /// @return The number of channels in the image.
+    std::size_t num_channels() const { return num_channels_; }
+
+    /// @brief Function to read the image data.
+    /// @return A span to the image data.
+    std::span<const T> readData() const { return data_.first(width_ * height_ * num_channels_); }
+
+    /// @brief Function to access the image data for writing in place.
+    /// @return A span to the image data.
+    std::span<T> data() const { return data_.first(width_ * height_ * num_channels_); }
+
+    /// @brief Pixel value at a given position in the image, see Image::pixelValue.
+    T &pixelValue(std::size_t const pixel_position_along_width, std::size_t const pixel_position_along_height, std::size_t const channel) const
+    {
+        auto const idx = channel * (height_ * width_) + (pixel_position_along_height * width_ + pixel_position_along_width);
+        assert(idx < width_ * height_ * num_channels_ && "Index out of bounds");
+        return data_[idx];
+    }
+
+private:
+    std::size_t width_;
+    std::size_t height_;
+    std::size_t num_channels_;
+    std::span<T> data_;
+};
+
+/// @brief Rectangle of pixels of an image, covering every channel.
+///
+struct ImageRegion
+{
+    std::size_t x{0U};      ///< Leftmost column of the region.
+    std::size_t y{0U};      ///< Top row of the region.
+    std::size_t width{0U};  ///< Number of columns of the region.
+    std::size_t height{0U}; ///< Number of rows of the region.
+
+    /// @brief Equality operator for comparing two regions.
+    bool operator==(const ImageRegion &other) const = default;
+};
 #endif // GENERAL_INTER_P_LIB_SRC_IMAGE_H
 
@@ -0,0 +1,93 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "latency_histogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+/// Count one duration
+void LatencyHistogram::record(std::uint64_t nanoseconds)
+{
+    buckets_[bucket(nanoseconds)].fetch_add(1U, std::memory_order_relaxed);
+    auto max = max_.load(std::memory_order_relaxed);
+    while (nanoseconds > max && !max_.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+/// Get the number of recorded durations
+std::uint64_t LatencyHistogram::count() const
+{
+    std::uint64_t total = 0U;
+    for (const auto &counter : buckets_)
+    {
+        total += counter.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/// Get a percentile of the recorded durations
+std::uint64_t LatencyHistogram::percentile(double quantile) const
+{
+    const auto total = count();
+    if (total == 0U)
+    {
+        return 0U;
+    }
+
+    const auto rank = std::max<std::uint64_t>(1U, static_cast<std::uint64_t>(std::ceil(quantile * static_cast<double>(total))));
+    std::uint64_t seen = 0U;
+    for (std::size_t i = 0U; i < kBucketCount; ++i)
+    {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            // The bucket bound may overshoot the largest sample.
+            return std::min(upperBound(i), max_.load(std::memory_order_relaxed));
+        }
+    }
+    return max_.load(std::memory_order_relaxed);
+}
+
+/// Get the usual percentiles
+LatencyStats LatencyHistogram::stats() const
+{
+    return LatencyStats{count(), percentile(0.5), percentile(0.99), percentile(0.999), max_.load(std::memory_order_relaxed)};
+}
+
+/// Forget every recorded duration
+void LatencyHistogram::reset()
+{
+    for (auto &counter : buckets_)
+    {
+        counter.store(0U, std::memory_order_relaxed);
+    }
+    max_.store(0U, std::memory_order_relaxed);
+}
+
+/// Get the bucket of a duration
+std::size_t LatencyHistogram::bucket(std::uint64_t nanoseconds)
+{
+    if (nanoseconds < kSubBuckets)
+    {
+        return static_cast<std::size_t>(nanoseconds);
+    }
+    // Durations in [2^e, 2^(e+1)) are split into kSubBuckets buckets by their next 3 bits.
+    const auto exponent = static_cast<std::size_t>(std::bit_width(nanoseconds)) - 1U;
+    const auto sub = static_cast<std::size_t>(nanoseconds >> (exponent - 3U)) & (kSubBuckets - 1U);
+    return (exponent - 2U) * kSubBuckets + sub;
+}
+
+/// Get the largest duration counted in a bucket
+std::uint64_t LatencyHistogram::upperBound(std::size_t bucket)
+{
+    if (bucket < kSubBuckets)
+    {
+        return bucket;
+    }
+    const auto exponent = bucket / kSubBuckets + 2U;
+    const auto sub = bucket % kSubBuckets;
+    const auto next = static_cast<std::uint64_t>(kSubBuckets + sub + 1U) << (exponent - 3U);
+    return next == 0U ? UINT64_MAX : next - 1U;
+}
@@ -0,0 +1,81 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the LatencyHistogram class.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_LATENCY_HISTOGRAM_H
+#define GENERAL_INTER_P_LIB_SRC_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Percentiles of a LatencyHistogram, in nanoseconds.
+///
+struct LatencyStats
+{
+    std::uint64_t count{0U}; ///< Number of recorded samples.
+    std::uint64_t p50{0U};   ///< Median.
+    std::uint64_t p99{0U};   ///< 99th percentile.
+    std::uint64_t p999{0U};  ///< 99.9th percentile.
+    std::uint64_t max{0U};   ///< Largest sample.
+};
+
+/// @brief The LatencyHistogram class counts durations in log-linear buckets, meant to be
+/// placed in shared memory so any attached process can query it.
+///
+/// Each power of two is split into 8 buckets, so percentiles are reported with at most
+/// 12.5 % error over the whole range of 64-bit nanosecond durations. Recording is one
+/// relaxed atomic increment; the buckets live in a fixed array, unlike a Boost.Histogram
+/// whose storage is allocated on the heap of one process.
+///
+class LatencyHistogram final
+{
+public:
+    static constexpr std::size_t kSubBuckets = 8U;                 ///< Buckets per power of two.
+    static constexpr std::size_t kBucketCount = 62U * kSubBuckets; ///< Buckets covering every 64-bit value.
+
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram &) = delete;
+    LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+    /// @brief Count one duration.
+    /// @param nanoseconds The duration in nanoseconds.
+    ///
+    void record(std::uint64_t nanoseconds);
+
+    /// @brief Get the number of recorded durations.
+    std::uint64_t count() const;
+
+    /// @brief Get a percentile of the recorded durations.
+    /// @param quantile The quantile in [0, 1], e.g. 0.99.
+    /// @return The upper bound of the bucket holding the percentile, 0 if nothing was recorded.
+    ///
+    std::uint64_t percentile(double quantile) const;
+
+    /// @brief Get the usual percentiles at once.
+    LatencyStats stats() const;
+
+    /// @brief Forget every recorded duration.
+    ///
+    void reset();
+
+    /// @brief Get the current time of the monotonic clock shared by all processes.
+    /// @return The steady clock time in nanoseconds.
+    static std::int64_t now() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+private:
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Counters must be lock-free to be shared between processes");
+
+    /// @brief Get the bucket of a duration.
+    static std::size_t bucket(std::uint64_t nanoseconds);
+
+    /// @brief Get the largest duration counted in a bucket.
+    static std::uint64_t upperBound(std::size_t bucket);
+
+    std::array<std::atomic<std::uint64_t>, kBucketCount> buckets_{}; ///< Number of durations per bucket.
+    std::atomic<std::uint64_t> max_{0U};                             ///< Largest recorded duration.
+};
+
+#endif // GENERAL_INTER_P_LIB_SRC_LATENCY_HISTOGRAM_H
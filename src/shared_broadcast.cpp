@@ -0,0 +1,195 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "shared_broadcast.h"
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <stdexcept>
+#include <cerrno>
+#include <signal.h>
+#include <unistd.h>
+
+/// Constructor to create or open the broadcast ring in shared memory.
+template <typename T>
+SharedBroadcast<T>::SharedBroadcast(const std::string &name, std::size_t capacity, std::size_t max_subscribers, const SegmentOptions &options)
+    : segment_(name, slotsOffset(max_subscribers) + capacity * sizeof(T), options, layoutHash<ControlBlock>()),
+      control_(nullptr),
+      cursors_(nullptr),
+      slots_(nullptr)
+{
+    assert(capacity > 0U && "Capacity must be greater than 0");
+    auto *base = static_cast<unsigned char *>(segment_.address());
+    cursors_ = static_cast<Cursor *>(static_cast<void *>(base + cursorsOffset()));
+    slots_ = static_cast<T *>(static_cast<void *>(base + slotsOffset(max_subscribers)));
+    if (!segment_.owner())
+    {
+        control_ = std::launder(static_cast<ControlBlock *>(segment_.address()));
+        return;
+    }
+
+    control_ = new (base) ControlBlock(capacity, max_subscribers);
+    for (std::size_t i = 0U; i < max_subscribers; ++i)
+    {
+        new (cursors_ + i) Cursor();
+    }
+    for (std::size_t i = 0U; i < capacity; ++i)
+    {
+        new (slots_ + i) T();
+    }
+    segment_.markInitialized();
+}
+
+/// Destructor
+template <typename T>
+SharedBroadcast<T>::~SharedBroadcast()
+{
+    if (!segment_.owner())
+    {
+        return;
+    }
+    for (std::size_t i = 0U; i < control_->capacity; ++i)
+    {
+        slots_[i].~T();
+    }
+    for (std::size_t i = 0U; i < control_->max_subscribers; ++i)
+    {
+        cursors_[i].~Cursor();
+    }
+    control_->~ControlBlock();
+}
+
+/// Publish data to every subscriber
+template <typename T>
+typename SharedBroadcast<T>::WriteStatus SharedBroadcast<T>::write(const T &data)
+{
+    const auto head = control_->head.load(std::memory_order_relaxed);
+    for (std::size_t i = 0U; i < control_->max_subscribers; ++i)
+    {
+        if (cursors_[i].state.load(std::memory_order_seq_cst) == kActive &&
+            head - cursors_[i].position.load(std::memory_order_acquire) >= control_->capacity)
+        {
+            if (subscriberAlive(i))
+            {
+                return WriteStatus::Full;
+            }
+            // The subscriber exited without unregistering: drop its cursor.
+            auto expected = static_cast<std::uint32_t>(kActive);
+            cursors_[i].state.compare_exchange_strong(expected, kFree, std::memory_order_seq_cst);
+        }
+    }
+
+    slots_[head % control_->capacity] = data;
+
+    control_->head.store(head + 1U, std::memory_order_seq_cst);
+    if (control_->waiters.load(std::memory_order_seq_cst) != 0U)
+    {
+        boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(control_->mutex);
+        control_->cond_var.notify_all();
+    }
+    return WriteStatus::Success;
+}
+
+/// Register a new subscriber
+template <typename T>
+typename SharedBroadcast<T>::Subscriber SharedBroadcast<T>::subscribe()
+{
+    for (std::size_t i = 0U; i < control_->max_subscribers; ++i)
+    {
+        auto expected = static_cast<std::uint32_t>(kFree);
+        if (!cursors_[i].state.compare_exchange_strong(expected, kClaimed, std::memory_order_seq_cst))
+        {
+            continue;
+        }
+
+        // The writer ignores the cursor until it is active. Reading head again once
+        // active moves the cursor past any slot the writer reused in the meantime.
+        cursors_[i].pid.store(static_cast<std::int32_t>(getpid()), std::memory_order_relaxed);
+        cursors_[i].position.store(control_->head.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        cursors_[i].state.store(kActive, std::memory_order_seq_cst);
+        cursors_[i].position.store(control_->head.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        return Subscriber(this, i);
+    }
+    throw std::runtime_error("No free subscriber cursor");
+}
+
+/// Number of registered subscribers
+template <typename T>
+std::size_t SharedBroadcast<T>::subscribers() const
+{
+    std::size_t count = 0U;
+    for (std::size_t i = 0U; i < control_->max_subscribers; ++i)
+    {
+        if (cursors_[i].state.load(std::memory_order_acquire) == kActive)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/// Tell whether the process of a subscriber still exists
+template <typename T>
+bool SharedBroadcast<T>::subscriberAlive(std::size_t cursor) const
+{
+    const auto pid = static_cast<pid_t>(cursors_[cursor].pid.load(std::memory_order_relaxed));
+    // Signal 0 only checks the process; EPERM means it exists but belongs to another user.
+    return kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+/// Read the next frame of a subscriber, waiting if it is up to date
+template <typename T>
+T SharedBroadcast<T>::readAt(std::size_t cursor)
+{
+    while (true)
+    {
+        if (auto data = tryReadAt(cursor))
+        {
+            return std::move(*data);
+        }
+
+        boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(control_->mutex);
+        control_->waiters.fetch_add(1U, std::memory_order_seq_cst);
+        while (control_->head.load(std::memory_order_seq_cst) == cursors_[cursor].position.load(std::memory_order_relaxed))
+        {
+            control_->cond_var.wait(lock);
+        }
+        control_->waiters.fetch_sub(1U, std::memory_order_relaxed);
+    }
+}
+
+/// Read the next frame of a subscriber without blocking
+template <typename T>
+std::optional<T> SharedBroadcast<T>::tryReadAt(std::size_t cursor)
+{
+    auto &position = cursors_[cursor].position;
+    const auto next = position.load(std::memory_order_relaxed);
+    if (next == control_->head.load(std::memory_order_acquire))
+    {
+        return std::nullopt;
+    }
+
+    std::optional<T> data(slots_[next % control_->capacity]);
+    position.store(next + 1U, std::memory_order_release);
+    return data;
+}
+
+/// Number of frames pending for a subscriber
+template <typename T>
+std::size_t SharedBroadcast<T>::pendingAt(std::size_t cursor) const
+{
+    const auto next = cursors_[cursor].position.load(std::memory_order_relaxed);
+    return control_->head.load(std::memory_order_acquire) - next;
+}
+
+/// Unregister a subscriber
+template <typename T>
+void SharedBroadcast<T>::unsubscribe(std::size_t cursor)
+{
+    cursors_[cursor].state.store(kFree, std::memory_order_release);
+}
+
+// Explicit template instantiation
+template class SharedBroadcast<int>;
+template class SharedBroadcast<float>;
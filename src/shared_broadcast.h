@@ -0,0 +1,182 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the SharedBroadcast class.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_SHARED_BROADCAST_H
+#define GENERAL_INTER_P_LIB_SRC_SHARED_BROADCAST_H
+
+#include "shared_segment.h"
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+/// @brief The SharedBroadcast class template fans out every frame of one producer
+/// to any number of subscribers through a ring of slots in shared memory.
+///
+/// Each subscriber registers a cursor in the segment header and consumes every
+/// frame independently; the producer writes each frame exactly once. A slot is
+/// only reused once every active subscriber has read it, so the slowest
+/// subscriber applies back-pressure to the producer.
+///
+/// Each cursor records the process id of its subscriber. When a cursor holds the writer
+/// back, the writer checks that its process still exists and frees the cursor of a
+/// subscriber that exited without unregistering, e.g. after a crash, instead of reporting
+/// Full forever. A dead subscriber whose process id was already reused by another process
+/// is not detected.
+///
+/// @tparam T template to allow different data types for the slots. The slots are read by
+/// subscriber processes, so T must be trivially copyable; a type owning heap memory would
+/// leave pointers into the writer's heap in the segment.
+///
+/// @pre At most one process/thread writes, and each Subscriber is used by one thread.
+///
+template <typename T>
+class SharedBroadcast
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SharedBroadcast slots are shared between processes and must be trivially copyable");
+
+public:
+    /// @brief Enum to represent the status of a write operation.
+    ///
+    enum class WriteStatus
+    {
+        Success, ///< Indicates a successful write operation.
+        Full     ///< Indicates the slowest subscriber still needs every slot; nothing was written.
+    };
+
+    /// @brief Constructor to create or attach to the broadcast ring in shared memory.
+    /// @param name The name of the shared memory object.
+    /// @param capacity The number of slots of the ring.
+    /// @param max_subscribers The number of subscriber cursors in the header.
+    /// @param options The options of the segment, e.g. OpenMode::Attach for subscriber processes.
+    ///
+    /// @pre capacity > 0.
+    ///
+    SharedBroadcast(const std::string &name, std::size_t capacity, std::size_t max_subscribers, const SegmentOptions &options = {});
+
+    /// @brief Destructor to clean up shared memory.
+    ///
+    ~SharedBroadcast();
+
+    SharedBroadcast(const SharedBroadcast &) = delete;
+    SharedBroadcast &operator=(const SharedBroadcast &) = delete;
+
+    /// @brief Publish data to every subscriber without blocking.
+    /// @param data The data to be written to the next slot.
+    /// @return WriteStatus::Full if a live subscriber has not yet read the slot to be reused.
+    ///
+    WriteStatus write(const T &data);
+
+    /// @brief Registered cursor of one subscriber; unregisters on destruction.
+    ///
+    class Subscriber
+    {
+    public:
+        Subscriber(Subscriber &&other) noexcept : owner_(other.owner_), cursor_(other.cursor_) { other.owner_ = nullptr; }
+        Subscriber(const Subscriber &) = delete;
+        Subscriber &operator=(const Subscriber &) = delete;
+        Subscriber &operator=(Subscriber &&) = delete;
+
+        ~Subscriber()
+        {
+            if (owner_)
+            {
+                owner_->unsubscribe(cursor_);
+            }
+        }
+
+        /// @brief Take the next frame, waiting until the producer publishes it.
+        /// @return The next frame for this subscriber.
+        T read() { return owner_->readAt(cursor_); }
+
+        /// @brief Take the next frame without blocking.
+        /// @return The next frame, or std::nullopt if this subscriber is up to date.
+        std::optional<T> try_read() { return owner_->tryReadAt(cursor_); }
+
+        /// @brief Get the number of frames published but not yet read by this subscriber.
+        /// @return The number of pending frames.
+        std::size_t pending() const { return owner_->pendingAt(cursor_); }
+
+    private:
+        friend class SharedBroadcast;
+        Subscriber(SharedBroadcast *owner, std::size_t cursor) : owner_(owner), cursor_(cursor) {}
+
+        SharedBroadcast *owner_; ///< Broadcast ring, nullptr once moved from.
+        std::size_t cursor_;     ///< Index of the cursor in the header.
+    };
+
+    /// @brief Register a new subscriber, starting at the next published frame.
+    /// @return The Subscriber owning the cursor.
+    /// @throws std::runtime_error if every cursor is already in use.
+    ///
+    Subscriber subscribe();
+
+    /// @brief Get the number of registered subscribers.
+    /// @return The number of active cursors.
+    std::size_t subscribers() const;
+
+    /// @brief Get the number of slots of the ring.
+    /// @return The capacity of the ring.
+    std::size_t capacity() const { return control_->capacity; }
+
+private:
+    static_assert(std::atomic<std::size_t>::is_always_lock_free, "Ring indices must be lock-free to be shared between processes");
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Cursor states must be lock-free to be shared between processes");
+
+    /// @brief State of a cursor slot in the header.
+    enum CursorState : std::uint32_t
+    {
+        kFree = 0U,    ///< Not in use.
+        kClaimed = 1U, ///< Being registered, ignored by the writer.
+        kActive = 2U   ///< Registered, its position holds back the writer.
+    };
+
+    /// @brief Read position of one subscriber, on its own cache line.
+    ///
+    struct alignas(kCacheLineSize) Cursor
+    {
+        std::atomic<std::uint32_t> state{kFree}; ///< One of CursorState.
+        std::atomic<std::size_t> position{0U};   ///< Sequence number of the next frame to read.
+        std::atomic<std::int32_t> pid{0};        ///< Process id of the subscriber.
+    };
+
+    /// @brief Structure placed at the start of the segment, followed by the cursors and the slots.
+    ///
+    struct ControlBlock
+    {
+        ControlBlock(std::size_t slot_count, std::size_t cursor_count) : capacity(slot_count), max_subscribers(cursor_count) {}
+
+        alignas(kCacheLineSize) std::atomic<std::size_t> head{0U};      ///< Sequence number of the next frame to write.
+        alignas(kCacheLineSize) std::atomic<std::uint32_t> waiters{0U}; ///< Number of subscribers parked on cond_var.
+        std::size_t capacity;                                           ///< Number of slots.
+        std::size_t max_subscribers;                                    ///< Number of cursors.
+        boost::interprocess::interprocess_mutex mutex;                  ///< Mutex protecting the parked subscribers.
+        boost::interprocess::interprocess_condition cond_var;           ///< Condition variable to wake parked subscribers.
+    };
+
+    /// @brief Offset of the first cursor from the start of the segment.
+    static constexpr std::size_t cursorsOffset() { return alignUp(sizeof(ControlBlock), alignof(Cursor)); }
+
+    /// @brief Offset of the first slot from the start of the segment.
+    static constexpr std::size_t slotsOffset(std::size_t max_subscribers) { return alignUp(cursorsOffset() + max_subscribers * sizeof(Cursor), alignof(T)); }
+
+    /// @brief Tell whether the process of a registered subscriber still exists.
+    bool subscriberAlive(std::size_t cursor) const;
+
+    T readAt(std::size_t cursor);
+    std::optional<T> tryReadAt(std::size_t cursor);
+    std::size_t pendingAt(std::size_t cursor) const;
+    void unsubscribe(std::size_t cursor);
+
+    SharedSegment segment_; ///< Shared memory segment holding the ring.
+    ControlBlock *control_; ///< Pointer to the control block.
+    Cursor *cursors_;       ///< Pointer to the first cursor.
+    T *slots_;              ///< Pointer to the first slot.
+};
+
+#endif // GENERAL_INTER_P_LIB_SRC_SHARED_BROADCAST_H
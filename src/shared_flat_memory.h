@@ -0,0 +1,281 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the SharedFlatMemory class.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_SHARED_FLAT_MEMORY_H
+#define GENERAL_INTER_P_LIB_SRC_SHARED_FLAT_MEMORY_H
+
+#include "futex_event.h"
+#include "shared_segment.h"
+#include "shm_traits.h"
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <string>
+
+/// @brief The SharedFlatMemory class template shares a value between processes in its flat
+/// layout described by shm_traits<T>, resident in the shared memory segment.
+///
+/// Unlike SharedMemory<T>, which places the object itself in the segment, so that the buffer
+/// of a std::vector or an Image stays on the writer's heap, every byte of the value is
+/// serialized into the segment. Readers in any process deserialize it or view it in place.
+/// Types without a flat layout are rejected at compile time.
+///
+/// @tparam T The type of the shared value, with a shm_traits<T> specialization.
+///
+template <ShmSerializable T>
+class SharedFlatMemory
+{
+private:
+    struct SharedData;
+
+public:
+    using Traits = shm_traits<T>;                ///< Flat layout of the shared value.
+    using ViewType = typename Traits::view_type; ///< Read-only view over the flat layout.
+
+    static_assert(Traits::alignment <= kCacheLineSize, "The flat layout needs a stronger alignment than the buffer has");
+
+    /// @brief Enum to represent the status of a write operation.
+    ///
+    enum class WriteStatus
+    {
+        Success, ///< Indicates a successful write operation.
+        Failure  ///< Indicates a failed write operation, e.g. a value larger than the segment.
+    };
+
+    /// @brief Constructor to create or attach to the shared value.
+    /// @param name The name of the shared memory object.
+    /// @param capacity The maximum number of bytes of the flat layout of a value, see shm_traits<T>::flat_size().
+    /// @param options The options of the segment, e.g. huge page backing for large values.
+    /// @throws std::runtime_error if attaching to a missing or incompatible segment.
+    ///
+    SharedFlatMemory(const std::string &name, std::size_t capacity, const SegmentOptions &options = {});
+
+    /// @brief Destructor to clean up shared memory.
+    ///
+    ~SharedFlatMemory();
+
+    SharedFlatMemory(const SharedFlatMemory &) = delete;
+    SharedFlatMemory &operator=(const SharedFlatMemory &) = delete;
+
+    /// @brief Serialize a value into the shared buffer.
+    /// @param data The value to be written to shared memory.
+    /// @return WriteStatus::Failure if the flat layout of the value does not fit into the segment.
+    ///
+    WriteStatus write(const T &data);
+
+    /// @brief Wait for a new value and deserialize it.
+    /// @return The value read from shared memory.
+    ///
+    T read() const;
+
+    /// @brief Wait for a new value and deserialize it into a caller-owned object.
+    /// @param out The object receiving the value.
+    ///
+    void read_into(T &out) const;
+
+    /// @brief Deserialize the value of the next write without consuming it, e.g. to record a channel next to its readers.
+    /// @param out The object receiving the value.
+    /// @param sequence In: the sequence number of the last observed write, 0 or sequence() initially.
+    /// Out: the sequence number of the write deserialized into out; a gap means writes were missed.
+    /// @param deadline The point in time after which to give up.
+    /// @return false on timeout.
+    ///
+    bool observe_until(T &out, std::uint64_t &sequence, std::chrono::steady_clock::time_point deadline) const;
+
+    /// @brief Get the sequence number of the last write, e.g. to observe only the writes that follow.
+    /// @return The number of writes so far.
+    ///
+    std::uint64_t sequence() const;
+
+    /// @brief Read-only view of the flat value, loaned to the consumer.
+    /// The bytes stay valid until release() is called or the loan is destroyed; the writer blocks in the meantime.
+    ///
+    class ReadLoan
+    {
+    public:
+        ReadLoan(ReadLoan &&other) noexcept : shared_data_(other.shared_data_), bytes_(other.bytes_) { other.shared_data_ = nullptr; }
+        ReadLoan(const ReadLoan &) = delete;
+        ReadLoan &operator=(const ReadLoan &) = delete;
+        ReadLoan &operator=(ReadLoan &&) = delete;
+
+        ~ReadLoan() { release(); }
+
+        /// @brief View the value in shared memory, e.g. a std::span for a std::vector.
+        /// @pre The loan has not been released.
+        ViewType view() const { return Traits::view(bytes_); }
+
+        /// @brief Get the flat bytes of the value in shared memory.
+        /// @pre The loan has not been released.
+        std::span<const unsigned char> bytes() const { return bytes_; }
+
+        /// @brief Mark the value as consumed and give the buffer back to the writer.
+        ///
+        void release()
+        {
+            if (shared_data_)
+            {
+                shared_data_->new_data = false;
+                shared_data_->mutex.unlock();
+                shared_data_ = nullptr;
+            }
+        }
+
+    private:
+        friend class SharedFlatMemory;
+        ReadLoan(SharedData *shared_data, std::span<const unsigned char> bytes) : shared_data_(shared_data), bytes_(bytes) {}
+
+        SharedData *shared_data_;              ///< Loaned shared data, nullptr once released.
+        std::span<const unsigned char> bytes_; ///< Flat bytes of the value in shared memory.
+    };
+
+    /// @brief Wait for a new value and loan its flat bytes to the caller.
+    /// @return A ReadLoan giving direct access to the value in shared memory.
+    ///
+    ReadLoan acquire_read_slot() const;
+
+    /// @brief Get the maximum number of bytes the buffer can hold.
+    /// @return The capacity of the buffer.
+    std::size_t capacity() const { return shared_data_->capacity; }
+
+    /// @brief Get the segment holding the value.
+    /// @return The shared memory segment.
+    const SharedSegment &segment() const { return segment_; }
+
+private:
+    /// @brief Fixed header placed at the start of the segment, followed by the flat buffer.
+    ///
+    struct SharedData
+    {
+        explicit SharedData(std::size_t byte_capacity) : capacity(byte_capacity) {}
+
+        bool new_data{false};                                 ///< Flag to indicate if new data is available.
+        std::size_t size{0U};                                 ///< Number of bytes of the value held in the buffer.
+        std::size_t capacity;                                 ///< Number of bytes the buffer can hold.
+        std::uint64_t sequence{0U};                           ///< Number of writes so far.
+        boost::interprocess::interprocess_mutex mutex;        ///< Mutex for synchronizing access.
+        boost::interprocess::interprocess_condition cond_var; ///< Condition variable for synchronization
+        FutexEvent event;                                     ///< Bumped on every write, for the observers.
+    };
+
+    /// @brief Offset of the flat buffer from the start of the segment, on its own cache line.
+    static constexpr std::size_t bufferOffset() { return alignUp(sizeof(SharedData), kCacheLineSize); }
+
+    SharedSegment segment_;   ///< Shared memory segment holding the value.
+    SharedData *shared_data_; ///< Pointer to the header.
+    unsigned char *buffer_;   ///< Pointer to the flat buffer.
+};
+
+/// Constructor to create or open the shared value.
+template <ShmSerializable T>
+SharedFlatMemory<T>::SharedFlatMemory(const std::string &name, std::size_t capacity, const SegmentOptions &options)
+    : segment_(name, bufferOffset() + capacity, options, layoutHash<SharedData>()),
+      shared_data_(nullptr),
+      buffer_(nullptr)
+{
+    auto *base = static_cast<unsigned char *>(segment_.address());
+    shared_data_ = segment_.owner() ? new (base) SharedData(capacity) : std::launder(static_cast<SharedData *>(segment_.address()));
+    buffer_ = base + bufferOffset();
+    segment_.markInitialized();
+}
+
+/// Destructor
+template <ShmSerializable T>
+SharedFlatMemory<T>::~SharedFlatMemory()
+{
+    if (segment_.owner())
+    {
+        shared_data_->~SharedData();
+    }
+}
+
+/// Serialize a value into shared memory
+template <ShmSerializable T>
+typename SharedFlatMemory<T>::WriteStatus SharedFlatMemory<T>::write(const T &data)
+{
+    const auto size = Traits::flat_size(data);
+    if (size > shared_data_->capacity)
+    {
+        return WriteStatus::Failure;
+    }
+
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+    Traits::serialize(data, std::span<unsigned char>(buffer_, size));
+    shared_data_->size = size;
+    shared_data_->new_data = true;
+    ++shared_data_->sequence;
+    shared_data_->cond_var.notify_all();
+    lock.unlock();
+    shared_data_->event.notify_all();
+    return WriteStatus::Success;
+}
+
+/// Deserialize a value from shared memory
+template <ShmSerializable T>
+T SharedFlatMemory<T>::read() const
+{
+    T out{};
+    read_into(out);
+    return out;
+}
+
+/// Deserialize a value into a caller-owned object
+template <ShmSerializable T>
+void SharedFlatMemory<T>::read_into(T &out) const
+{
+    const auto loan = acquire_read_slot();
+    Traits::deserialize(loan.bytes(), out);
+}
+
+/// Deserialize the next write without consuming it
+template <ShmSerializable T>
+bool SharedFlatMemory<T>::observe_until(T &out, std::uint64_t &sequence, std::chrono::steady_clock::time_point deadline) const
+{
+    while (true)
+    {
+        // Load the futex word first, so a write racing with the check below changes it.
+        const auto seen = shared_data_->event.value();
+        {
+            boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+            if (shared_data_->sequence != sequence)
+            {
+                Traits::deserialize(std::span<const unsigned char>(buffer_, shared_data_->size), out);
+                sequence = shared_data_->sequence;
+                return true;
+            }
+        }
+        if (!shared_data_->event.wait_until(seen, 0U, deadline))
+        {
+            return false;
+        }
+    }
+}
+
+/// Get the sequence number of the last write
+template <ShmSerializable T>
+std::uint64_t SharedFlatMemory<T>::sequence() const
+{
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+    return shared_data_->sequence;
+}
+
+/// Loan the flat buffer for reading
+template <ShmSerializable T>
+typename SharedFlatMemory<T>::ReadLoan SharedFlatMemory<T>::acquire_read_slot() const
+{
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+    while (!shared_data_->new_data)
+    {
+        shared_data_->cond_var.wait(lock);
+    }
+    lock.release();
+
+    return ReadLoan(shared_data_, std::span<const unsigned char>(buffer_, shared_data_->size));
+}
+
+#endif // GENERAL_INTER_P_LIB_SRC_SHARED_FLAT_MEMORY_H
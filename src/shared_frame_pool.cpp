@@ -0,0 +1,108 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "shared_frame_pool.h"
+#include <cassert>
+#include <new>
+
+/// Constructor to create or open the pool.
+template <typename T>
+SharedFramePool<T>::SharedFramePool(const std::string &name, std::size_t frame_size, std::uint32_t frame_count, const SegmentOptions &options)
+    : segment_(name, framesOffset(frame_count) + frame_count * frameStride(frame_size), options, layoutHash<Header>()),
+      header_(nullptr),
+      slots_(nullptr),
+      frames_(nullptr)
+{
+    assert(frame_count > 0U && "Frame count must be greater than 0");
+    auto *base = static_cast<unsigned char *>(segment_.address());
+    frames_ = base + framesOffset(frame_count);
+    if (!segment_.owner())
+    {
+        header_ = std::launder(static_cast<Header *>(segment_.address()));
+        slots_ = std::launder(static_cast<Slot *>(static_cast<void *>(base + slotsOffset())));
+        return;
+    }
+
+    header_ = new (base) Header(frame_size, frame_count);
+    slots_ = new (base + slotsOffset()) Slot[frame_count];
+    segment_.markInitialized();
+}
+
+/// Destructor
+template <typename T>
+SharedFramePool<T>::~SharedFramePool()
+{
+    if (segment_.owner())
+    {
+        header_->~Header();
+    }
+}
+
+/// Take a free frame
+template <typename T>
+std::optional<typename SharedFramePool<T>::Frame> SharedFramePool<T>::try_acquire()
+{
+    const auto count = header_->frame_count;
+    const auto start = header_->next.load(std::memory_order_relaxed);
+    for (std::uint32_t i = 0U; i < count; ++i)
+    {
+        const auto index = (start + i) % count;
+        std::uint32_t expected = 0U;
+        // Acquire pairs with the release in release(), so the previous users are done with the frame.
+        if (slots_[index].refcount.compare_exchange_strong(expected, 1U, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            header_->next.store((index + 1U) % count, std::memory_order_relaxed);
+            return Frame(this, index);
+        }
+    }
+    return std::nullopt;
+}
+
+/// Get the number of references to a frame
+template <typename T>
+std::uint32_t SharedFramePool<T>::refcount(std::uint32_t index) const
+{
+    assert(index < header_->frame_count && "Frame index out of range");
+    return slots_[index].refcount.load(std::memory_order_relaxed);
+}
+
+/// Get the number of free frames
+template <typename T>
+std::uint32_t SharedFramePool<T>::free_frames() const
+{
+    std::uint32_t count = 0U;
+    for (std::uint32_t i = 0U; i < header_->frame_count; ++i)
+    {
+        count += slots_[i].refcount.load(std::memory_order_relaxed) == 0U ? 1U : 0U;
+    }
+    return count;
+}
+
+/// Access the elements of a frame
+template <typename T>
+std::span<T> SharedFramePool<T>::frame(std::uint32_t index) const
+{
+    assert(index < header_->frame_count && "Frame index out of range");
+    return std::span<T>(static_cast<T *>(static_cast<void *>(frames_ + index * frameStride(header_->frame_size))), header_->frame_size);
+}
+
+/// Add a reference to a frame
+template <typename T>
+void SharedFramePool<T>::retain(std::uint32_t index) const
+{
+    // The caller already holds a reference, so the frame cannot be freed concurrently.
+    slots_[index].refcount.fetch_add(1U, std::memory_order_relaxed);
+}
+
+/// Drop a reference to a frame
+template <typename T>
+void SharedFramePool<T>::release(std::uint32_t index) const
+{
+    [[maybe_unused]] const auto previous = slots_[index].refcount.fetch_sub(1U, std::memory_order_release);
+    assert(previous > 0U && "Frame released more often than acquired");
+}
+
+// Explicit template instantiation
+template class SharedFramePool<std::uint8_t>;
+template class SharedFramePool<float>;
+template class SharedFramePool<std::size_t>;
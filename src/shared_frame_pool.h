@@ -0,0 +1,190 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the SharedFramePool class.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_SHARED_FRAME_POOL_H
+#define GENERAL_INTER_P_LIB_SRC_SHARED_FRAME_POOL_H
+
+#include "shared_segment.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+
+/// @brief The SharedFramePool class template preallocates fixed-size frame blocks in one
+/// shared memory segment, each with an atomic reference count.
+///
+/// A producer acquires a free frame, fills it in place and passes only its index to the
+/// next stage, e.g. over a SharedRingBuffer<std::uint32_t>. The reference travels with the
+/// index: detach() hands it over and adopt() takes it back, so a frame goes through a
+/// multi-stage pipeline without being copied and returns to the pool when its last
+/// reference is dropped. share() adds a reference for each additional consumer.
+///
+/// References held by a process that dies are not reclaimed.
+///
+/// @tparam T template for the element type of the frames.
+///
+template <typename T>
+class SharedFramePool
+{
+private:
+    struct Header;
+    struct Slot;
+
+public:
+    /// @brief Reference to one frame of the pool, released on destruction.
+    ///
+    class Frame
+    {
+    public:
+        Frame(Frame &&other) noexcept : pool_(other.pool_), index_(other.index_) { other.pool_ = nullptr; }
+        Frame(const Frame &) = delete;
+        Frame &operator=(const Frame &) = delete;
+
+        Frame &operator=(Frame &&other) noexcept
+        {
+            if (this != &other)
+            {
+                if (pool_)
+                {
+                    pool_->release(index_);
+                }
+                pool_ = other.pool_;
+                index_ = other.index_;
+                other.pool_ = nullptr;
+            }
+            return *this;
+        }
+
+        ~Frame()
+        {
+            if (pool_)
+            {
+                pool_->release(index_);
+            }
+        }
+
+        /// @brief Get the index of the frame in the pool.
+        std::uint32_t index() const { return index_; }
+
+        /// @brief Access the elements of the frame in shared memory.
+        /// @pre The frame has not been detached.
+        std::span<T> data() const { return pool_->frame(index_); }
+
+        /// @brief Add a reference for another consumer.
+        /// @return A new reference to the same frame.
+        ///
+        Frame share() const
+        {
+            pool_->retain(index_);
+            return Frame(pool_, index_);
+        }
+
+        /// @brief Give up the handle without releasing the reference, to pass it on with the index.
+        /// @return The index to send to the next stage, which calls adopt() on it.
+        ///
+        std::uint32_t detach()
+        {
+            pool_ = nullptr;
+            return index_;
+        }
+
+    private:
+        friend class SharedFramePool;
+        Frame(const SharedFramePool *pool, std::uint32_t index) : pool_(pool), index_(index) {}
+
+        const SharedFramePool *pool_; ///< Pool of the frame, nullptr once detached.
+        std::uint32_t index_;         ///< Index of the frame in the pool.
+    };
+
+    /// @brief Constructor to create or attach to the pool.
+    /// @param name The name of the shared memory object.
+    /// @param frame_size The number of elements of each frame.
+    /// @param frame_count The number of frames in the pool.
+    /// @param options The options of the segment, e.g. huge page backing for large frames.
+    ///
+    SharedFramePool(const std::string &name, std::size_t frame_size, std::uint32_t frame_count, const SegmentOptions &options = {});
+
+    /// @brief Destructor to clean up shared memory.
+    ///
+    ~SharedFramePool();
+
+    SharedFramePool(const SharedFramePool &) = delete;
+    SharedFramePool &operator=(const SharedFramePool &) = delete;
+
+    /// @brief Take a free frame without blocking.
+    /// @return The only reference to the frame, or std::nullopt if every frame is in use.
+    ///
+    std::optional<Frame> try_acquire();
+
+    /// @brief Take over a reference passed on with detach(), possibly by another process.
+    /// @param index The index received from the previous stage.
+    /// @return The reference to the frame.
+    ///
+    Frame adopt(std::uint32_t index) const { return Frame(this, index); }
+
+    /// @brief Get the number of references to a frame.
+    /// @param index The index of the frame.
+    /// @return 0 if the frame is free.
+    ///
+    std::uint32_t refcount(std::uint32_t index) const;
+
+    /// @brief Get the number of free frames, a snapshot that may be stale at once.
+    std::uint32_t free_frames() const;
+
+    /// @brief Get the number of frames in the pool.
+    std::uint32_t frame_count() const { return header_->frame_count; }
+
+    /// @brief Get the number of elements of each frame.
+    std::size_t frame_size() const { return header_->frame_size; }
+
+private:
+    /// @brief Pool geometry placed at the start of the segment, followed by the slots and the frames.
+    ///
+    struct Header
+    {
+        Header(std::size_t size, std::uint32_t count) : frame_size(size), frame_count(count) {}
+
+        std::size_t frame_size;                 ///< Number of elements of each frame.
+        std::uint32_t frame_count;              ///< Number of frames.
+        std::atomic<std::uint32_t> next{0U};    ///< Where try_acquire() starts looking for a free frame.
+    };
+
+    /// @brief Reference count of one frame, on its own cache line.
+    ///
+    struct alignas(kCacheLineSize) Slot
+    {
+        std::atomic<std::uint32_t> refcount{0U}; ///< Number of references, 0 when the frame is free.
+    };
+
+    static_assert(std::is_trivially_copyable_v<T>, "Frames are handed between processes as raw memory");
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Reference counts must be lock-free to be shared between processes");
+
+    /// @brief Offset of the first slot from the start of the segment.
+    static constexpr std::size_t slotsOffset() { return alignUp(sizeof(Header), alignof(Slot)); }
+
+    /// @brief Offset of the first frame from the start of the segment.
+    static constexpr std::size_t framesOffset(std::uint32_t frame_count) { return alignUp(slotsOffset() + frame_count * sizeof(Slot), kCacheLineSize); }
+
+    /// @brief Distance between two frames, keeping every frame cache-line aligned.
+    static constexpr std::size_t frameStride(std::size_t frame_size) { return alignUp(frame_size * sizeof(T), kCacheLineSize); }
+
+    /// @brief Access the elements of a frame.
+    std::span<T> frame(std::uint32_t index) const;
+
+    /// @brief Add a reference to a frame.
+    void retain(std::uint32_t index) const;
+
+    /// @brief Drop a reference to a frame, freeing it with the last one.
+    void release(std::uint32_t index) const;
+
+    SharedSegment segment_;  ///< Shared memory segment holding the pool.
+    Header *header_;         ///< Pointer to the pool geometry.
+    Slot *slots_;            ///< Pointer to the reference counts.
+    unsigned char *frames_;  ///< Pointer to the first frame.
+};
+
+#endif // GENERAL_INTER_P_LIB_SRC_SHARED_FRAME_POOL_H
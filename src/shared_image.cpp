@@ -0,0 +1,173 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "shared_image.h"
+#include "copy_kernel.h"
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+/// Copy one region of every channel between two images of the same shape.
+template <typename T>
+void copyRegion(const T *source, T *destination, std::size_t width, std::size_t height, std::size_t num_channels, const ImageRegion &region)
+{
+    for (std::size_t channel = 0U; channel < num_channels; ++channel)
+    {
+        for (std::size_t row = region.y; row < region.y + region.height; ++row)
+        {
+            const auto offset = channel * width * height + row * width + region.x;
+            std::copy(source + offset, source + offset + region.width, destination + offset);
+        }
+    }
+}
+} // namespace
+
+/// Constructor to create or open the shared image.
+template <typename T>
+SharedImage<T>::SharedImage(const std::string &name, std::size_t data_size, const SegmentOptions &options)
+    : segment_(name, pixelsOffset() + data_size * sizeof(T), options, layoutHash<SharedData>()),
+      shared_data_(nullptr),
+      pixels_(nullptr)
+{
+    auto *base = static_cast<unsigned char *>(segment_.address());
+    shared_data_ = segment_.owner() ? new (base) SharedData(data_size) : std::launder(static_cast<SharedData *>(segment_.address()));
+    pixels_ = static_cast<T *>(static_cast<void *>(base + pixelsOffset()));
+    segment_.markInitialized();
+}
+
+/// Destructor
+template <typename T>
+SharedImage<T>::~SharedImage()
+{
+    if (segment_.owner())
+    {
+        shared_data_->~SharedData();
+    }
+}
+
+/// Write an image to shared memory
+template <typename T>
+typename SharedImage<T>::WriteStatus SharedImage<T>::write(const Image<T> &image)
+{
+    const auto pixels = image.readData();
+    if (pixels.size() > shared_data_->capacity)
+    {
+        return WriteStatus::Failure;
+    }
+
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+    copyElements(pixels.data(), pixels.size(), pixels_);
+    shared_data_->width = image.width();
+    shared_data_->height = image.height();
+    shared_data_->num_channels = image.num_channels();
+    shared_data_->markAllDirty();
+    shared_data_->new_data = true;
+    shared_data_->cond_var.notify_all();
+    return WriteStatus::Success;
+}
+
+/// Write the changed regions of an image to shared memory
+template <typename T>
+typename SharedImage<T>::WriteStatus SharedImage<T>::write_regions(const Image<T> &image, std::span<const ImageRegion> regions)
+{
+    for (const auto &region : regions)
+    {
+        if (region.x + region.width > image.width() || region.y + region.height > image.height())
+        {
+            return WriteStatus::Failure;
+        }
+    }
+
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+    if (image.width() != shared_data_->width || image.height() != shared_data_->height || image.num_channels() != shared_data_->num_channels)
+    {
+        return WriteStatus::Failure;
+    }
+    if (!shared_data_->new_data)
+    {
+        // The previous dirty set was consumed, start a new one.
+        shared_data_->dirty_count = 0U;
+    }
+    for (const auto &region : regions)
+    {
+        if (region.width == 0U || region.height == 0U)
+        {
+            continue;
+        }
+        copyRegion(image.readData().data(), pixels_, image.width(), image.height(), image.num_channels(), region);
+        shared_data_->addDirty(region);
+    }
+    shared_data_->new_data = true;
+    shared_data_->cond_var.notify_all();
+    return WriteStatus::Success;
+}
+
+/// Bring a reader-owned copy of the image up to date
+template <typename T>
+std::vector<ImageRegion> SharedImage<T>::read_delta(Image<T> &copy) const
+{
+    const auto loan = acquire_read_slot();
+    if (copy.width() != loan->width() || copy.height() != loan->height() || copy.num_channels() != loan->num_channels())
+    {
+        const auto pixels = loan->readData();
+        copy = Image<T>(std::vector<T>(pixels.begin(), pixels.end()), loan->width(), loan->height(), loan->num_channels());
+        return {ImageRegion{0U, 0U, loan->width(), loan->height()}};
+    }
+
+    const auto dirty = loan.dirty();
+    if (copy.size() != 0U)
+    {
+        for (const auto &region : dirty)
+        {
+            copyRegion(loan->readData().data(), &copy.pixelValue(0U, 0U, 0U), copy.width(), copy.height(), copy.num_channels(), region);
+        }
+    }
+    return std::vector<ImageRegion>(dirty.begin(), dirty.end());
+}
+
+/// Read an image from shared memory
+template <typename T>
+Image<T> SharedImage<T>::read() const
+{
+    const auto loan = acquire_read_slot();
+    const auto pixels = loan->readData();
+    return Image<T>(std::vector<T>(pixels.begin(), pixels.end()), loan->width(), loan->height(), loan->num_channels());
+}
+
+/// Loan the pixel buffer for writing
+template <typename T>
+typename SharedImage<T>::WriteLoan SharedImage<T>::acquire_write_slot(std::size_t width, std::size_t height, std::size_t num_channels)
+{
+    const auto count = width * height * num_channels;
+    if (count > shared_data_->capacity)
+    {
+        throw std::length_error("Image does not fit into the shared memory segment");
+    }
+
+    shared_data_->mutex.lock();
+    return WriteLoan(shared_data_, ImageView<T>(std::span<T>(pixels_, count), width, height, num_channels));
+}
+
+/// Loan the pixel buffer for reading
+template <typename T>
+typename SharedImage<T>::ReadLoan SharedImage<T>::acquire_read_slot() const
+{
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+    while (!shared_data_->new_data)
+    {
+        shared_data_->cond_var.wait(lock);
+    }
+    lock.release();
+
+    const auto count = shared_data_->width * shared_data_->height * shared_data_->num_channels;
+    return ReadLoan(shared_data_, ImageView<const T>(std::span<const T>(pixels_, count), shared_data_->width, shared_data_->height, shared_data_->num_channels));
+}
+
+// Explicit template instantiation
+template class SharedImage<std::size_t>;
+template class SharedImage<std::uint8_t>;
@@ -0,0 +1,257 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the SharedImage class.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_SHARED_IMAGE_H
+#define GENERAL_INTER_P_LIB_SRC_SHARED_IMAGE_H
+
+#include "image.h"
+#include "shared_segment.h"
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/// @brief The SharedImage class template shares an image between processes with its
+/// pixels resident in the shared memory segment.
+///
+/// An Image keeps its pixel vector on the heap, so SharedMemory cannot carry it. Here
+/// the segment holds a fixed header followed by a contiguous pixel buffer, so another
+/// process can read the pixels straight from the mapping.
+///
+/// @tparam T template to allow different data types for the image pixels.
+///
+template <typename T>
+class SharedImage
+{
+private:
+    struct SharedData;
+
+public:
+    /// @brief Enum to represent the status of a write operation.
+    ///
+    enum class WriteStatus
+    {
+        Success, ///< Indicates a successful write operation.
+        Failure  ///< Indicates a failed write operation, e.g. an image larger than the segment.
+    };
+
+    /// @brief Maximum number of regions kept in the dirty set before they are merged.
+    static constexpr std::size_t kMaxDirtyRegions = 16U;
+
+    /// @brief Constructor to create or attach to the shared image.
+    /// @param name The name of the shared memory object.
+    /// @param data_size The maximum number of pixel values (width * height * num_channels) to be stored.
+    /// @param options The options of the segment, e.g. huge page backing for large images.
+    ///
+    SharedImage(const std::string &name, std::size_t data_size, const SegmentOptions &options = {});
+
+    /// @brief Destructor to clean up shared memory.
+    ///
+    ~SharedImage();
+
+    SharedImage(const SharedImage &) = delete;
+    SharedImage &operator=(const SharedImage &) = delete;
+
+    /// @brief Copy an image into the shared pixel buffer.
+    /// @param image The image to be written to shared memory.
+    /// @return WriteStatus::Failure if the image does not fit into the segment.
+    ///
+    WriteStatus write(const Image<T> &image);
+
+    /// @brief Copy only the changed regions of an image into the resident image.
+    /// The regions are added to the dirty set exposed to readers, which accumulates until a reader consumes the image.
+    /// @param image The new image, of the same shape as the resident one.
+    /// @param regions The regions of image that differ from the resident image.
+    /// @return WriteStatus::Failure if the shape differs from the resident image or a region is out of bounds.
+    ///
+    WriteStatus write_regions(const Image<T> &image, std::span<const ImageRegion> regions);
+
+    /// @brief Bring a reader-owned copy of the image up to date, waiting for new data.
+    /// Only the dirty regions are copied, unless the shape of copy differs from the resident image.
+    /// @param copy The reader's copy of the image.
+    /// @return The regions copied into copy.
+    ///
+    std::vector<ImageRegion> read_delta(Image<T> &copy) const;
+
+    /// @brief Read the image from shared memory, waiting for new data.
+    /// @return A copy of the image held in shared memory.
+    ///
+    Image<T> read() const;
+
+    /// @brief Writable view of the shared image, loaned to the producer.
+    /// The shared mutex is held for the lifetime of the loan.
+    ///
+    class WriteLoan
+    {
+    public:
+        WriteLoan(WriteLoan &&other) noexcept : shared_data_(other.shared_data_), view_(other.view_) { other.shared_data_ = nullptr; }
+        WriteLoan(const WriteLoan &) = delete;
+        WriteLoan &operator=(const WriteLoan &) = delete;
+        WriteLoan &operator=(WriteLoan &&) = delete;
+
+        ~WriteLoan()
+        {
+            if (shared_data_)
+            {
+                shared_data_->mutex.unlock();
+            }
+        }
+
+        /// @brief Access the pixels in shared memory.
+        /// @pre The loan has not been committed.
+        const ImageView<T> &operator*() const { return view_; }
+        const ImageView<T> *operator->() const { return &view_; }
+
+        /// @brief Publish the image to the readers and give the buffer back.
+        /// @return WriteStatus::Failure if the loan was already committed.
+        ///
+        WriteStatus commit()
+        {
+            if (!shared_data_)
+            {
+                return WriteStatus::Failure;
+            }
+            shared_data_->width = view_.width();
+            shared_data_->height = view_.height();
+            shared_data_->num_channels = view_.num_channels();
+            shared_data_->markAllDirty();
+            shared_data_->new_data = true;
+            shared_data_->mutex.unlock();
+            shared_data_->cond_var.notify_all();
+            shared_data_ = nullptr;
+            return WriteStatus::Success;
+        }
+
+    private:
+        friend class SharedImage;
+        WriteLoan(SharedData *shared_data, ImageView<T> view) : shared_data_(shared_data), view_(view) {}
+
+        SharedData *shared_data_; ///< Loaned shared data, nullptr once committed.
+        ImageView<T> view_;       ///< View of the pixels in shared memory.
+    };
+
+    /// @brief Read-only view of the shared image, loaned to the consumer.
+    /// The pixels stay valid until release() is called or the loan is destroyed.
+    ///
+    class ReadLoan
+    {
+    public:
+        ReadLoan(ReadLoan &&other) noexcept : shared_data_(other.shared_data_), view_(other.view_) { other.shared_data_ = nullptr; }
+        ReadLoan(const ReadLoan &) = delete;
+        ReadLoan &operator=(const ReadLoan &) = delete;
+        ReadLoan &operator=(ReadLoan &&) = delete;
+
+        ~ReadLoan() { release(); }
+
+        /// @brief Access the pixels in shared memory.
+        /// @pre The loan has not been released.
+        const ImageView<const T> &operator*() const { return view_; }
+        const ImageView<const T> *operator->() const { return &view_; }
+
+        /// @brief Get the regions written since the image was last consumed.
+        /// @pre The loan has not been released.
+        std::span<const ImageRegion> dirty() const { return std::span<const ImageRegion>(shared_data_->dirty.data(), shared_data_->dirty_count); }
+
+        /// @brief Mark the image as consumed and give the buffer back to the writer.
+        ///
+        void release()
+        {
+            if (shared_data_)
+            {
+                shared_data_->new_data = false;
+                shared_data_->mutex.unlock();
+                shared_data_ = nullptr;
+            }
+        }
+
+    private:
+        friend class SharedImage;
+        ReadLoan(SharedData *shared_data, ImageView<const T> view) : shared_data_(shared_data), view_(view) {}
+
+        SharedData *shared_data_; ///< Loaned shared data, nullptr once released.
+        ImageView<const T> view_; ///< View of the pixels in shared memory.
+    };
+
+    /// @brief Loan the pixel buffer to the caller to fill an image of the given shape in place.
+    /// @param width Width of the image.
+    /// @param height Height of the image.
+    /// @param num_channels Number of channels in the image.
+    /// @return A WriteLoan giving direct access to the pixels in shared memory.
+    /// @throws std::length_error if the image does not fit into the segment.
+    ///
+    WriteLoan acquire_write_slot(std::size_t width, std::size_t height, std::size_t num_channels = 1);
+
+    /// @brief Wait for a new image and loan its pixels to the caller.
+    /// @return A ReadLoan giving direct access to the pixels in shared memory.
+    ///
+    ReadLoan acquire_read_slot() const;
+
+    /// @brief Get the maximum number of pixel values the segment can hold.
+    /// @return The capacity of the pixel buffer.
+    std::size_t capacity() const { return shared_data_->capacity; }
+
+    /// @brief Tell whether the segment is backed by huge pages.
+    /// @return false if huge pages were not requested or not available.
+    bool hugePages() const { return segment_.hugePages(); }
+
+    /// @brief Get the segment holding the image, e.g. to query its warm-up time.
+    /// @return The shared memory segment.
+    const SharedSegment &segment() const { return segment_; }
+
+private:
+    /// @brief Fixed header placed at the start of the segment, followed by the pixel buffer.
+    ///
+    struct SharedData
+    {
+        explicit SharedData(std::size_t pixel_capacity) : capacity(pixel_capacity) {}
+
+        /// @brief Replace the dirty set with the whole image.
+        void markAllDirty()
+        {
+            dirty[0] = ImageRegion{0U, 0U, width, height};
+            dirty_count = 1U;
+        }
+
+        /// @brief Add a region to the dirty set; once the set is full, the last entry grows to cover the new regions.
+        void addDirty(const ImageRegion &region)
+        {
+            if (dirty_count < kMaxDirtyRegions)
+            {
+                dirty[dirty_count++] = region;
+                return;
+            }
+            auto &last = dirty[kMaxDirtyRegions - 1U];
+            const auto right = std::max(last.x + last.width, region.x + region.width);
+            const auto bottom = std::max(last.y + last.height, region.y + region.height);
+            last.x = std::min(last.x, region.x);
+            last.y = std::min(last.y, region.y);
+            last.width = right - last.x;
+            last.height = bottom - last.y;
+        }
+
+        bool new_data{false};                                 ///< Flag to indicate if new data is available.
+        std::size_t width{0U};                                ///< Width of the image held in the buffer.
+        std::size_t height{0U};                               ///< Height of the image held in the buffer.
+        std::size_t num_channels{0U};                         ///< Number of channels of the image held in the buffer.
+        std::size_t capacity;                                 ///< Number of pixel values the buffer can hold.
+        std::uint32_t dirty_count{0U};                        ///< Number of regions in the dirty set.
+        std::array<ImageRegion, kMaxDirtyRegions> dirty{};    ///< Regions written since the image was last consumed.
+        boost::interprocess::interprocess_mutex mutex;        ///< Mutex for synchronizing access.
+        boost::interprocess::interprocess_condition cond_var; ///< Condition variable for synchronization
+    };
+
+    /// @brief Offset of the pixel buffer from the start of the segment.
+    static constexpr std::size_t pixelsOffset() { return alignUp(sizeof(SharedData), alignof(T)); }
+
+    SharedSegment segment_;   ///< Shared memory segment holding the image.
+    SharedData *shared_data_; ///< Pointer to the image header.
+    T *pixels_;               ///< Pointer to the pixel buffer.
+};
+
+#endif // GENERAL_INTER_P_LIB_SRC_SHARED_IMAGE_H
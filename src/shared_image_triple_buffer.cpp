@@ -0,0 +1,113 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "shared_image_triple_buffer.h"
+#include "copy_kernel.h"
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+/// Constructor to create or open the triple buffer.
+template <typename T>
+SharedImageTripleBuffer<T>::SharedImageTripleBuffer(const std::string &name, std::size_t data_size, const SegmentOptions &options)
+    : segment_(name, pixelsOffset() + 3U * alignUp(data_size * sizeof(T), kCacheLineSize), options, layoutHash<SharedData>()),
+      shared_data_(segment_.owner() ? new (segment_.address()) SharedData(data_size) : std::launder(static_cast<SharedData *>(segment_.address())))
+{
+    segment_.markInitialized();
+}
+
+/// Destructor
+template <typename T>
+SharedImageTripleBuffer<T>::~SharedImageTripleBuffer()
+{
+    if (segment_.owner())
+    {
+        shared_data_->~SharedData();
+    }
+}
+
+/// Copy an image into the back buffer and publish it
+template <typename T>
+typename SharedImageTripleBuffer<T>::WriteStatus SharedImageTripleBuffer<T>::write(const Image<T> &image)
+{
+    const auto data = image.readData();
+    if (data.size() > shared_data_->capacity)
+    {
+        return WriteStatus::Failure;
+    }
+
+    copyElements(data.data(), data.size(), pixels(shared_data_->back));
+    publish(image.width(), image.height(), image.num_channels());
+    return WriteStatus::Success;
+}
+
+/// Loan the back buffer for writing
+template <typename T>
+typename SharedImageTripleBuffer<T>::WriteLoan SharedImageTripleBuffer<T>::acquire_write_slot(std::size_t width, std::size_t height, std::size_t num_channels)
+{
+    const auto count = width * height * num_channels;
+    if (count > shared_data_->capacity)
+    {
+        throw std::length_error("Image does not fit into the shared memory segment");
+    }
+    return WriteLoan(this, ImageView<T>(std::span<T>(pixels(shared_data_->back), count), width, height, num_channels));
+}
+
+/// Take the newest published image as front buffer
+template <typename T>
+bool SharedImageTripleBuffer<T>::update()
+{
+    if ((shared_data_->middle.load(std::memory_order_relaxed) & kFresh) == 0U)
+    {
+        return false;
+    }
+    const auto previous = shared_data_->middle.exchange(shared_data_->front, std::memory_order_acq_rel);
+    shared_data_->front = previous & ~kFresh;
+    return true;
+}
+
+/// View of the front buffer
+template <typename T>
+ImageView<const T> SharedImageTripleBuffer<T>::front() const
+{
+    const auto index = shared_data_->front;
+    const auto &header = shared_data_->headers[index];
+    const auto count = header.width * header.height * header.num_channels;
+    return ImageView<const T>(std::span<const T>(pixels(index), count), header.width, header.height, header.num_channels);
+}
+
+/// Read the newest published image
+template <typename T>
+Image<T> SharedImageTripleBuffer<T>::read()
+{
+    update();
+    const auto view = front();
+    const auto data = view.readData();
+    return Image<T>(std::vector<T>(data.begin(), data.end()), view.width(), view.height(), view.num_channels());
+}
+
+/// Pointer to the pixels of a buffer
+template <typename T>
+T *SharedImageTripleBuffer<T>::pixels(std::uint32_t index) const
+{
+    auto *base = static_cast<unsigned char *>(segment_.address());
+    return static_cast<T *>(static_cast<void *>(base + pixelsOffset() + index * bufferStride()));
+}
+
+/// Swap the back buffer with the middle buffer
+template <typename T>
+void SharedImageTripleBuffer<T>::publish(std::size_t width, std::size_t height, std::size_t num_channels)
+{
+    auto &header = shared_data_->headers[shared_data_->back];
+    header.width = width;
+    header.height = height;
+    header.num_channels = num_channels;
+
+    const auto previous = shared_data_->middle.exchange(shared_data_->back | kFresh, std::memory_order_acq_rel);
+    shared_data_->back = previous & ~kFresh;
+}
+
+// Explicit template instantiation
+template class SharedImageTripleBuffer<std::size_t>;
+template class SharedImageTripleBuffer<std::uint8_t>;
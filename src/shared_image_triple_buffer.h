@@ -0,0 +1,178 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the SharedImageTripleBuffer class.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_SHARED_IMAGE_TRIPLE_BUFFER_H
+#define GENERAL_INTER_P_LIB_SRC_SHARED_IMAGE_TRIPLE_BUFFER_H
+
+#include "image.h"
+#include "shared_segment.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// @brief The SharedImageTripleBuffer class template exchanges images between one
+/// producer and one consumer through three pixel buffers resident in shared memory.
+///
+/// The writer always owns a free back buffer and the reader always owns the front
+/// buffer it is looking at. The third buffer holds the newest complete image and is
+/// swapped with a single atomic exchange, so neither side ever waits for the other,
+/// however slow the reader is.
+///
+/// @tparam T template to allow different data types for the image pixels.
+///
+/// @pre At most one process/thread writes and at most one process/thread reads.
+///
+template <typename T>
+class SharedImageTripleBuffer
+{
+public:
+    /// @brief Enum to represent the status of a write operation.
+    ///
+    enum class WriteStatus
+    {
+        Success, ///< Indicates a successful write operation.
+        Failure  ///< Indicates a failed write operation, e.g. an image larger than a buffer.
+    };
+
+    /// @brief Constructor to create or attach to the triple buffer.
+    /// @param name The name of the shared memory object.
+    /// @param data_size The maximum number of pixel values (width * height * num_channels) of one image.
+    /// @param options The options of the segment, e.g. huge page backing for large images.
+    ///
+    SharedImageTripleBuffer(const std::string &name, std::size_t data_size, const SegmentOptions &options = {});
+
+    /// @brief Destructor to clean up shared memory.
+    ///
+    ~SharedImageTripleBuffer();
+
+    SharedImageTripleBuffer(const SharedImageTripleBuffer &) = delete;
+    SharedImageTripleBuffer &operator=(const SharedImageTripleBuffer &) = delete;
+
+    /// @brief Copy an image into the back buffer and publish it.
+    /// @param image The image to be written to shared memory.
+    /// @return WriteStatus::Failure if the image does not fit into a buffer.
+    ///
+    WriteStatus write(const Image<T> &image);
+
+    /// @brief Writable view of the back buffer, loaned to the producer.
+    ///
+    class WriteLoan
+    {
+    public:
+        WriteLoan(WriteLoan &&other) noexcept : owner_(other.owner_), view_(other.view_) { other.owner_ = nullptr; }
+        WriteLoan(const WriteLoan &) = delete;
+        WriteLoan &operator=(const WriteLoan &) = delete;
+        WriteLoan &operator=(WriteLoan &&) = delete;
+        ~WriteLoan() = default;
+
+        /// @brief Access the pixels of the back buffer.
+        /// @pre The loan has not been committed.
+        const ImageView<T> &operator*() const { return view_; }
+        const ImageView<T> *operator->() const { return &view_; }
+
+        /// @brief Publish the back buffer as the newest image.
+        /// @return WriteStatus::Failure if the loan was already committed.
+        ///
+        WriteStatus commit()
+        {
+            if (!owner_)
+            {
+                return WriteStatus::Failure;
+            }
+            owner_->publish(view_.width(), view_.height(), view_.num_channels());
+            owner_ = nullptr;
+            return WriteStatus::Success;
+        }
+
+    private:
+        friend class SharedImageTripleBuffer;
+        WriteLoan(SharedImageTripleBuffer *owner, ImageView<T> view) : owner_(owner), view_(view) {}
+
+        SharedImageTripleBuffer *owner_; ///< Owner of the back buffer, nullptr once committed.
+        ImageView<T> view_;              ///< View of the back buffer pixels.
+    };
+
+    /// @brief Loan the back buffer to the caller to fill an image of the given shape in place.
+    /// @param width Width of the image.
+    /// @param height Height of the image.
+    /// @param num_channels Number of channels in the image.
+    /// @return A WriteLoan giving direct access to the back buffer.
+    /// @throws std::length_error if the image does not fit into a buffer.
+    ///
+    WriteLoan acquire_write_slot(std::size_t width, std::size_t height, std::size_t num_channels = 1);
+
+    /// @brief Take the newest published image as front buffer, if there is one.
+    /// @return true if a new image was published since the last update.
+    ///
+    bool update();
+
+    /// @brief View of the front buffer owned by the reader.
+    /// It stays valid and unchanged until the next update() or read().
+    /// @return The image in the front buffer, empty if nothing was published yet.
+    ///
+    ImageView<const T> front() const;
+
+    /// @brief Read the newest published image without blocking.
+    /// @return A copy of the newest image, empty if nothing was published yet.
+    ///
+    Image<T> read();
+
+    /// @brief Get the maximum number of pixel values of one image.
+    /// @return The capacity of each buffer.
+    std::size_t capacity() const { return shared_data_->capacity; }
+
+    /// @brief Tell whether the segment is backed by huge pages.
+    /// @return false if huge pages were not requested or not available.
+    bool hugePages() const { return segment_.hugePages(); }
+
+    /// @brief Get the segment holding the image, e.g. to query its warm-up time.
+    /// @return The shared memory segment.
+    const SharedSegment &segment() const { return segment_; }
+
+private:
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Buffer exchange must be lock-free to be shared between processes");
+
+    /// @brief Flag set in SharedData::middle when it holds an image the reader has not seen.
+    static constexpr std::uint32_t kFresh = 4U;
+
+    /// @brief Shape of the image held by a buffer.
+    ///
+    struct BufferHeader
+    {
+        std::size_t width{0U};        ///< Width of the image.
+        std::size_t height{0U};       ///< Height of the image.
+        std::size_t num_channels{0U}; ///< Number of channels of the image.
+    };
+
+    /// @brief Structure placed at the start of the segment, followed by the three pixel buffers.
+    ///
+    struct SharedData
+    {
+        explicit SharedData(std::size_t pixel_capacity) : capacity(pixel_capacity) {}
+
+        alignas(kCacheLineSize) std::atomic<std::uint32_t> middle{2U}; ///< Index of the middle buffer, plus kFresh.
+        alignas(kCacheLineSize) std::uint32_t back{0U};                ///< Index of the buffer owned by the writer.
+        alignas(kCacheLineSize) std::uint32_t front{1U};               ///< Index of the buffer owned by the reader.
+        std::size_t capacity;                                          ///< Number of pixel values of each buffer.
+        BufferHeader headers[3];                                       ///< Shape of the image held by each buffer.
+    };
+
+    /// @brief Offset of the first pixel buffer from the start of the segment.
+    static constexpr std::size_t pixelsOffset() { return alignUp(sizeof(SharedData), kCacheLineSize); }
+
+    /// @brief Distance between two pixel buffers, a whole number of cache lines.
+    std::size_t bufferStride() const { return alignUp(shared_data_->capacity * sizeof(T), kCacheLineSize); }
+
+    /// @brief Pointer to the pixels of a buffer.
+    T *pixels(std::uint32_t index) const;
+
+    /// @brief Record the shape of the back buffer and swap it with the middle buffer.
+    void publish(std::size_t width, std::size_t height, std::size_t num_channels);
+
+    SharedSegment segment_;   ///< Shared memory segment holding the buffers.
+    SharedData *shared_data_; ///< Pointer to the control block.
+};
+
+#endif // GENERAL_INTER_P_LIB_SRC_SHARED_IMAGE_TRIPLE_BUFFER_H
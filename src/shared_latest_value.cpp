@@ -0,0 +1,85 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "shared_latest_value.h"
+#include <array>
+#include <cstring>
+#include <new>
+#include <thread>
+
+/// Constructor to create or open the shared value.
+template <typename T>
+SharedLatestValue<T>::SharedLatestValue(const std::string &name, const SegmentOptions &options)
+    : segment_(name, sizeof(SharedData), options, layoutHash<SharedData>()),
+      shared_data_(segment_.owner() ? new (segment_.address()) SharedData() : std::launder(static_cast<SharedData *>(segment_.address())))
+{
+    segment_.markInitialized();
+}
+
+/// Destructor
+template <typename T>
+SharedLatestValue<T>::~SharedLatestValue()
+{
+    if (segment_.owner())
+    {
+        shared_data_->~SharedData();
+    }
+}
+
+/// Publish a new value
+template <typename T>
+typename SharedLatestValue<T>::WriteStatus SharedLatestValue<T>::write(const T &data)
+{
+    Word words[kWordCount] = {};
+    std::memcpy(words, &data, sizeof(T));
+
+    const auto sequence = shared_data_->sequence.load(std::memory_order_relaxed);
+    shared_data_->sequence.store(sequence + 1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0U; i < kWordCount; ++i)
+    {
+        shared_data_->words[i].store(words[i], std::memory_order_relaxed);
+    }
+    shared_data_->sequence.store(sequence + 2U, std::memory_order_release);
+    return WriteStatus::Success;
+}
+
+/// Read the newest value and its version
+template <typename T>
+typename SharedLatestValue<T>::Snapshot SharedLatestValue<T>::snapshot() const
+{
+    Word words[kWordCount];
+    while (true)
+    {
+        const auto before = shared_data_->sequence.load(std::memory_order_acquire);
+        if ((before & 1U) != 0U)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        for (std::size_t i = 0U; i < kWordCount; ++i)
+        {
+            words[i] = shared_data_->words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (shared_data_->sequence.load(std::memory_order_relaxed) == before)
+        {
+            Snapshot snapshot{T{}, before / 2U};
+            std::memcpy(&snapshot.value, words, sizeof(T));
+            return snapshot;
+        }
+    }
+}
+
+/// Number of published writes
+template <typename T>
+std::uint64_t SharedLatestValue<T>::version() const
+{
+    return shared_data_->sequence.load(std::memory_order_acquire) / 2U;
+}
+
+// Explicit template instantiation
+template class SharedLatestValue<int>;
+template class SharedLatestValue<float>;
+template class SharedLatestValue<double>;
+template class SharedLatestValue<std::array<float, 16>>;
@@ -0,0 +1,105 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the SharedLatestValue class.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_SHARED_LATEST_VALUE_H
+#define GENERAL_INTER_P_LIB_SRC_SHARED_LATEST_VALUE_H
+
+#include "shared_segment.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+/// @brief The SharedLatestValue class template publishes the newest value of a
+/// trivially copyable type through a seqlock in shared memory.
+///
+/// The writer bumps a sequence counter to an odd value, stores the value and bumps
+/// it back to an even value. Readers copy the value and retry if the counter changed
+/// meanwhile. Neither side ever blocks the other, so any number of readers can poll
+/// without slowing down the writer.
+///
+/// @tparam T template for the published data, must be trivially copyable.
+///
+/// @pre At most one process/thread writes.
+///
+template <typename T>
+class SharedLatestValue
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SharedLatestValue requires a trivially copyable type");
+
+public:
+    /// @brief Enum to represent the status of a write operation.
+    ///
+    enum class WriteStatus
+    {
+        Success, ///< Indicates a successful write operation.
+        Failure  ///< Indicates a failed write operation.
+    };
+
+    /// @brief A value together with the number of writes it results from.
+    ///
+    struct Snapshot
+    {
+        T value;               ///< The value read from shared memory.
+        std::uint64_t version; ///< Number of writes published so far, 0 if none.
+    };
+
+    /// @brief Constructor to create or attach to the shared value.
+    /// @param name The name of the shared memory object.
+    /// @param options The options of the segment, e.g. OpenMode::Attach for a monitoring process.
+    ///
+    explicit SharedLatestValue(const std::string &name, const SegmentOptions &options = {});
+
+    /// @brief Destructor to clean up shared memory.
+    ///
+    ~SharedLatestValue();
+
+    SharedLatestValue(const SharedLatestValue &) = delete;
+    SharedLatestValue &operator=(const SharedLatestValue &) = delete;
+
+    /// @brief Publish a new value.
+    /// @param data The value to be written to shared memory.
+    /// @return WriteStatus indicating success or failure of the write operation.
+    ///
+    WriteStatus write(const T &data);
+
+    /// @brief Read the newest value without blocking.
+    /// @return The newest value, or a zero-filled T if nothing was written yet.
+    ///
+    T read() const { return snapshot().value; }
+
+    /// @brief Read the newest value and its version in one consistent step.
+    /// @return The newest value and the number of writes it results from.
+    ///
+    Snapshot snapshot() const;
+
+    /// @brief Get the number of writes published so far.
+    /// Readers can compare it to a previous snapshot to skip unchanged values.
+    /// @return The number of published writes.
+    ///
+    std::uint64_t version() const;
+
+private:
+    using Word = std::uint64_t;
+    static_assert(std::atomic<Word>::is_always_lock_free, "Seqlock words must be lock-free to be shared between processes");
+
+    /// @brief Number of atomic words holding the value.
+    static constexpr std::size_t kWordCount = (sizeof(T) + sizeof(Word) - 1U) / sizeof(Word);
+
+    /// @brief Structure to hold shared data.
+    /// The value is stored as atomic words so that a reader racing with the writer
+    /// reads stale or mixed words, never undefined data, and then retries.
+    ///
+    struct SharedData
+    {
+        alignas(kCacheLineSize) std::atomic<std::uint64_t> sequence{0U}; ///< Even when stable, odd while a write is in progress.
+        std::atomic<Word> words[kWordCount];                             ///< The value, split into words.
+    };
+
+    SharedSegment segment_;   ///< Shared memory segment holding the value.
+    SharedData *shared_data_; ///< Pointer to the shared data.
+};
+
+#endif // GENERAL_INTER_P_LIB_SRC_SHARED_LATEST_VALUE_H
@@ -1,34 +1,45 @@
 #include "shared_memory.h"
-#include "image.h"
+#include "copy_kernel.h"
 #include <boost/interprocess/allocators/allocator.hpp>
 #include <boost/interprocess/containers/vector.hpp>
 #include <boost/interprocess/managed_shared_memory.hpp>
-#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <array>
 #include <iostream>
+#include <new>
+
+namespace
+{
+/// Convert a steady clock deadline into the absolute UTC time expected by Boost.Interprocess.
+boost::posix_time::ptime toPosixTime(std::chrono::steady_clock::time_point deadline)
+{
+    const auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now());
+    return boost::posix_time::microsec_clock::universal_time() + boost::posix_time::microseconds(remaining.count());
+}
+} // namespace
 
 /// Constructor to create or open shared memory.
 template <typename T>
-SharedMemory<T>::SharedMemory(const std::string &name, std::size_t data_size)
-    : name_(name),
-      shm_(boost::interprocess::open_or_create, name.c_str(), boost::interprocess::read_write),
-      region_()
+SharedMemory<T>::SharedMemory(const std::string &name, std::size_t data_size, const SharedMemoryOptions &options)
+    : segment_(name, sizeof(SharedData) + data_size * sizeof(T), options.segment, layoutHash<SharedData>())
 {
-    shm_.truncate(sizeof(SharedData) + data_size * sizeof(T));
-    region_ = boost::interprocess::mapped_region(shm_, boost::interprocess::read_write);
-    void *addr = region_.get_address();
-    shared_data_ = new (addr) SharedData();
+    void *addr = segment_.address();
+    shared_data_ = segment_.owner() ? new (addr) SharedData(options) : std::launder(static_cast<SharedData *>(addr));
+    segment_.markInitialized();
+    if (options.eventfd_bridge)
+    {
+        bridge_ = std::make_unique<EventFdPublisher>(name);
+    }
 }
 
 /// Destructor
 template <typename T>
 SharedMemory<T>::~SharedMemory()
 {
-    if (shared_data_)
+    if (shared_data_ && segment_.owner())
     {
-        // Explicitly call the destructor of SharedData
+        // Explicitly call the destructor of SharedData, the segment removes the shared memory object.
         shared_data_->~SharedData();
-
-        boost::interprocess::shared_memory_object::remove(name_.c_str());
     }
 }
 
@@ -44,9 +55,22 @@ typename SharedMemory<T>::WriteStatus SharedMemory<T>::write(const T &data)
     boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
     if (shared_data_)
     {
-        shared_data_->data = data;
-        shared_data_->new_data = true;
-        shared_data_->cond_var.notify_all();
+        copyPayload(data, shared_data_->data);
+        shared_data_->publish();
+        if (shared_data_->options.notification == Notification::Futex)
+        {
+            // Readers re-take the mutex once woken, so wake them after releasing it.
+            lock.unlock();
+        }
+        shared_data_->notifyReaders();
+        if (bridge_)
+        {
+            if (lock)
+            {
+                lock.unlock();
+            }
+            bridge_->notify();
+        }
         return WriteStatus::Success; // Indicate success
     }
     return WriteStatus::Failure; // Indicate failure
@@ -62,16 +86,226 @@ T SharedMemory<T>::read() const
     }
 
     boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
-    while (!shared_data_->new_data)
+    shared_data_->waitForNewData(lock);
+    shared_data_->consume();
+    return shared_data_->data;
+}
+
+/// Read data from shared memory into a caller-owned object
+template <typename T>
+void SharedMemory<T>::read_into(T &out) const
+{
+    if (!shared_data_)
+    {
+        throw std::runtime_error("Shared data is nullptr");
+    }
+
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+    shared_data_->waitForNewData(lock);
+    shared_data_->consume();
+    copyPayload(shared_data_->data, out);
+}
+
+/// Read data from shared memory without blocking
+template <typename T>
+std::optional<T> SharedMemory<T>::try_read() const
+{
+    if (!shared_data_)
+    {
+        throw std::runtime_error("Shared data is nullptr");
+    }
+
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex, boost::interprocess::try_to_lock);
+    if (!lock || !shared_data_->new_data)
+    {
+        return std::nullopt;
+    }
+    shared_data_->consume();
+    return shared_data_->data;
+}
+
+/// Read data from shared memory with a timeout
+template <typename T>
+std::optional<T> SharedMemory<T>::read_for(std::chrono::steady_clock::duration timeout) const
+{
+    return read_until(std::chrono::steady_clock::now() + timeout);
+}
+
+/// Read data from shared memory with a deadline
+template <typename T>
+std::optional<T> SharedMemory<T>::read_until(std::chrono::steady_clock::time_point deadline) const
+{
+    if (!shared_data_)
     {
-        shared_data_->cond_var.wait(lock);
+        throw std::runtime_error("Shared data is nullptr");
     }
-    shared_data_->new_data = false;
+
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex, toPosixTime(deadline));
+    if (!lock || !waitForNewDataUntil(lock, deadline))
+    {
+        return std::nullopt;
+    }
+    shared_data_->consume();
     return shared_data_->data;
 }
 
+/// Loan the shared slot for writing
+template <typename T>
+typename SharedMemory<T>::WriteLoan SharedMemory<T>::acquire_write_slot()
+{
+    if (!shared_data_)
+    {
+        throw std::runtime_error("Shared data is nullptr");
+    }
+
+    shared_data_->mutex.lock();
+    return WriteLoan(shared_data_, bridge_.get());
+}
+
+/// Loan the shared slot for reading
+template <typename T>
+typename SharedMemory<T>::ReadLoan SharedMemory<T>::acquire_read_slot() const
+{
+    if (!shared_data_)
+    {
+        throw std::runtime_error("Shared data is nullptr");
+    }
+
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+    shared_data_->waitForNewData(lock);
+    lock.release();
+    return ReadLoan(shared_data_);
+}
+
+/// Get the latency percentiles
+template <typename T>
+LatencyStats SharedMemory<T>::latency() const
+{
+    if (!shared_data_)
+    {
+        throw std::runtime_error("Shared data is nullptr");
+    }
+    return shared_data_->latency.stats();
+}
+
+/// Get the inter-arrival percentiles
+template <typename T>
+LatencyStats SharedMemory<T>::inter_arrival() const
+{
+    if (!shared_data_)
+    {
+        throw std::runtime_error("Shared data is nullptr");
+    }
+    return shared_data_->inter_arrival.stats();
+}
+
+/// Forget the recorded stats
+template <typename T>
+void SharedMemory<T>::reset_stats()
+{
+    if (!shared_data_)
+    {
+        throw std::runtime_error("Shared data is nullptr");
+    }
+    shared_data_->latency.reset();
+    shared_data_->inter_arrival.reset();
+}
+
+/// Copy the data of the next write without consuming it
+template <typename T>
+bool SharedMemory<T>::observe_until(T &out, std::uint64_t &sequence, std::chrono::steady_clock::time_point deadline) const
+{
+    if (!shared_data_)
+    {
+        throw std::runtime_error("Shared data is nullptr");
+    }
+
+    while (true)
+    {
+        // Load the futex word first, so a write racing with the check below changes it.
+        const auto seen = shared_data_->event.value();
+        {
+            boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+            if (shared_data_->sequence != sequence)
+            {
+                out = shared_data_->data;
+                sequence = shared_data_->sequence;
+                return true;
+            }
+        }
+        if (!shared_data_->event.wait_until(seen, shared_data_->options.spin_count, deadline))
+        {
+            return false;
+        }
+    }
+}
+
+/// Get the sequence number of the last write
+template <typename T>
+std::uint64_t SharedMemory<T>::sequence() const
+{
+    if (!shared_data_)
+    {
+        throw std::runtime_error("Shared data is nullptr");
+    }
+
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+    return shared_data_->sequence;
+}
+
+/// Read the next value from a coroutine
+template <typename T>
+typename SharedMemory<T>::NextAwaitable SharedMemory<T>::next(ChannelLoop &loop) const
+{
+    if (!shared_data_)
+    {
+        throw std::runtime_error("Shared data is nullptr");
+    }
+
+    return NextAwaitable(this, loop);
+}
+
+/// Take new data without waiting
+template <typename T>
+bool SharedMemory<T>::takeNewData(T &out) const
+{
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+    if (!shared_data_->new_data)
+    {
+        return false;
+    }
+    shared_data_->consume();
+    out = shared_data_->data;
+    return true;
+}
+
+/// Wait for new data with a deadline
+template <typename T>
+bool SharedMemory<T>::waitForNewDataUntil(boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> &lock,
+                                          std::chrono::steady_clock::time_point deadline) const
+{
+    while (!shared_data_->new_data)
+    {
+        if (shared_data_->options.notification == Notification::Futex)
+        {
+            const auto seen = shared_data_->event.value();
+            lock.unlock();
+            const auto notified = shared_data_->event.wait_until(seen, shared_data_->options.spin_count, deadline);
+            lock.lock();
+            if (!notified)
+            {
+                return shared_data_->new_data;
+            }
+        }
+        else if (!shared_data_->cond_var.timed_wait(lock, toPosixTime(deadline)))
+        {
+            return shared_data_->new_data;
+        }
+    }
+    return true;
+}
+
 // Explicit template instantiation
 template class SharedMemory<int>;
 template class SharedMemory<float>;
-template class SharedMemory<Image<std::size_t>>;
-template class SharedMemory<std::vector<float>>;
+template class SharedMemory<std::array<float, 16>>;
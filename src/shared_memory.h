@@ -5,22 +5,60 @@
 
 #include <boost/interprocess/sync/interprocess_mutex.hpp>
 #include <boost/interprocess/sync/interprocess_condition.hpp>
-#include <boost/interprocess/shared_memory_object.hpp>
-#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include "channel_loop.h"
+#include "eventfd_bridge.h"
+#include "futex_event.h"
+#include "latency_histogram.h"
+#include "shared_segment.h"
+#include <chrono>
+#include <memory>
+#include <optional>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <cstddef>
+#include <cstdint>
+
+/// @brief Mechanism used to wake readers waiting for new data.
+///
+enum class Notification
+{
+    Condition, ///< Boost.Interprocess condition variable, notified on every write.
+    Futex      ///< Linux futex word with adaptive spinning; no system call when nobody waits.
+};
+
+/// @brief Options of a SharedMemory channel, fixed at construction.
+/// A process attaching with OpenMode::Attach uses the notification options of the creator.
+///
+struct SharedMemoryOptions
+{
+    Notification notification = Notification::Condition; ///< How readers are woken up.
+    std::uint32_t spin_count = 4000U;                    ///< Futex only: iterations to spin before parking.
+    SegmentOptions segment;                              ///< Memory backing the segment, e.g. huge pages.
+    bool eventfd_bridge = false;                         ///< Signal EventFdSubscribers of the channel on every write made through this instance.
+    bool latency_stats = false;                          ///< Time every write and read into the histograms of the stats block.
+};
 
 /// @brief The SharedMemory class template is designed to facilitate the sharing of data
 /// between processes using shared memory.
 /// It leverages the Boost.Interprocess library to manage synchronization and shared memory operations.
 ///
+/// The object itself is placed in the segment and read by the processes attaching to it, so T
+/// must be trivially copyable: the buffer of a std::vector or an Image would stay on the writer's
+/// heap. Use SharedFlatMemory to share such types between processes.
+///
 /// @tparam T template to allow different data types for the shared data.
 ///
 template <typename T>
 class SharedMemory
 {
+private:
+    struct SharedData;
+
 public:
+    static_assert(std::is_trivially_copyable_v<T>, "SharedMemory data is shared between processes and must be trivially copyable");
+
     /// @brief Enum to represent the status of a write operation.
     ///
     enum class WriteStatus
@@ -29,11 +67,16 @@ public:
         Failure  ///< Indicates a failed write operation.
     };
 
-    /// @brief Constructor to create or open shared memory.
+    /// @brief Constructor to create or attach to shared memory.
     /// @param name The name of the shared memory object.
     /// @param data_size The size of the data to be stored in shared memory.
+    /// @param options The options of the channel, e.g. the notification backend.
+    /// Set options.segment.open_mode to OpenMode::Attach to join a running channel without resetting it.
+    /// Set options.eventfd_bridge on the writing instance to let readers wait with epoll through an EventFdSubscriber.
+    /// @throws std::runtime_error if attaching to a missing or incompatible segment,
+    /// or if the eventfd bridge is already published by another instance.
     ///
-    SharedMemory(const std::string &name, std::size_t data_size);
+    SharedMemory(const std::string &name, std::size_t data_size, const SharedMemoryOptions &options = {});
 
     /// @brief Destructor to clean up shared memory.
     ///
@@ -51,6 +94,213 @@ public:
     ///
     T read() const;
 
+    /// @brief Read data from shared memory into a caller-owned object.
+    /// The data is copied straight into out, without a temporary, through copyPayload(),
+    /// so payloads of kStreamingCopyThreshold bytes or more use the streaming copy kernel.
+    /// @param out The object receiving the data.
+    /// @throws std::runtime_error if shared_data_ is nullptr.
+    ///
+    void read_into(T &out) const;
+
+    /// @brief Read data from shared memory without blocking.
+    /// @return The data read from shared memory, or std::nullopt if there is no new data
+    /// or the writer currently holds the lock.
+    /// @throws std::runtime_error if shared_data_ is nullptr.
+    ///
+    std::optional<T> try_read() const;
+
+    /// @brief Read data from shared memory, waiting at most for a given duration.
+    /// @param timeout The maximum time to wait for new data.
+    /// @return The data read from shared memory, or std::nullopt on timeout.
+    /// @throws std::runtime_error if shared_data_ is nullptr.
+    ///
+    std::optional<T> read_for(std::chrono::steady_clock::duration timeout) const;
+
+    /// @brief Read data from shared memory, waiting at most until a given point in time.
+    /// @param deadline The point in time after which to give up.
+    /// @return The data read from shared memory, or std::nullopt on timeout.
+    /// @throws std::runtime_error if shared_data_ is nullptr.
+    ///
+    std::optional<T> read_until(std::chrono::steady_clock::time_point deadline) const;
+
+    /// @brief Copy the data of the next write without consuming it, e.g. to record a channel next to its readers.
+    /// @param out The object receiving the data.
+    /// @param sequence In: the sequence number of the last observed write, 0 or sequence() initially.
+    /// Out: the sequence number of the write copied into out; a gap means writes were missed.
+    /// @param deadline The point in time after which to give up.
+    /// @return false on timeout.
+    /// @throws std::runtime_error if shared_data_ is nullptr.
+    ///
+    bool observe_until(T &out, std::uint64_t &sequence, std::chrono::steady_clock::time_point deadline) const;
+
+    /// @brief Get the sequence number of the last write, e.g. to observe only the writes that follow.
+    /// @return The number of writes so far.
+    /// @throws std::runtime_error if shared_data_ is nullptr.
+    ///
+    std::uint64_t sequence() const;
+
+    /// @brief Writable view of the shared slot, loaned to the producer.
+    /// The shared mutex is held for the lifetime of the loan, so the data can be
+    /// filled in place and then published with commit().
+    /// A loan destroyed without commit() leaves the previous data unpublished.
+    ///
+    class WriteLoan
+    {
+    public:
+        WriteLoan(WriteLoan &&other) noexcept : shared_data_(other.shared_data_), bridge_(other.bridge_) { other.shared_data_ = nullptr; }
+        WriteLoan(const WriteLoan &) = delete;
+        WriteLoan &operator=(const WriteLoan &) = delete;
+        WriteLoan &operator=(WriteLoan &&) = delete;
+
+        ~WriteLoan()
+        {
+            if (shared_data_)
+            {
+                shared_data_->mutex.unlock();
+            }
+        }
+
+        /// @brief Access the data in shared memory.
+        /// @pre The loan has not been committed.
+        T &operator*() const { return shared_data_->data; }
+        T *operator->() const { return &shared_data_->data; }
+
+        /// @brief Publish the data to the readers and give the slot back.
+        /// @return WriteStatus::Failure if the loan was already committed.
+        ///
+        WriteStatus commit()
+        {
+            if (!shared_data_)
+            {
+                return WriteStatus::Failure;
+            }
+            shared_data_->publish();
+            shared_data_->mutex.unlock();
+            shared_data_->notifyReaders();
+            if (bridge_)
+            {
+                bridge_->notify();
+            }
+            shared_data_ = nullptr;
+            return WriteStatus::Success;
+        }
+
+    private:
+        friend class SharedMemory;
+        WriteLoan(SharedData *shared_data, EventFdPublisher *bridge) : shared_data_(shared_data), bridge_(bridge) {}
+
+        SharedData *shared_data_;  ///< Loaned shared data, nullptr once committed.
+        EventFdPublisher *bridge_; ///< Eventfd bridge of the channel, nullptr if disabled.
+    };
+
+    /// @brief Read-only view of the shared slot, loaned to the consumer.
+    /// The data stays valid and is not overwritten until release() is called or
+    /// the loan is destroyed; the writer blocks in the meantime.
+    ///
+    class ReadLoan
+    {
+    public:
+        ReadLoan(ReadLoan &&other) noexcept : shared_data_(other.shared_data_) { other.shared_data_ = nullptr; }
+        ReadLoan(const ReadLoan &) = delete;
+        ReadLoan &operator=(const ReadLoan &) = delete;
+        ReadLoan &operator=(ReadLoan &&) = delete;
+
+        ~ReadLoan() { release(); }
+
+        /// @brief Access the data in shared memory.
+        /// @pre The loan has not been released.
+        const T &operator*() const { return shared_data_->data; }
+        const T *operator->() const { return &shared_data_->data; }
+
+        /// @brief Get the sequence number of the loaned write.
+        /// @pre The loan has not been released.
+        std::uint64_t sequence() const { return shared_data_->sequence; }
+
+        /// @brief Get the steady clock time of the loaned write in nanoseconds, see LatencyHistogram::now().
+        /// @pre The loan has not been released.
+        /// @return 0 unless the channel was created with options.latency_stats.
+        std::int64_t publish_ns() const { return shared_data_->publish_ns; }
+
+        /// @brief Mark the data as consumed and give the slot back to the writer.
+        ///
+        void release()
+        {
+            if (shared_data_)
+            {
+                shared_data_->consume();
+                shared_data_->mutex.unlock();
+                shared_data_ = nullptr;
+            }
+        }
+
+    private:
+        friend class SharedMemory;
+        explicit ReadLoan(SharedData *shared_data) : shared_data_(shared_data) {}
+
+        SharedData *shared_data_; ///< Loaned shared data, nullptr once released.
+    };
+
+    /// @brief Loan the shared slot to the caller for an in-place write.
+    /// @return A WriteLoan giving direct access to the data in shared memory.
+    /// @throws std::runtime_error if shared_data_ is nullptr.
+    ///
+    WriteLoan acquire_write_slot();
+
+    /// @brief Wait for new data and loan the shared slot to the caller for an in-place read.
+    /// @return A ReadLoan giving direct access to the data in shared memory.
+    /// @throws std::runtime_error if shared_data_ is nullptr.
+    ///
+    ReadLoan acquire_read_slot() const;
+
+    /// @brief Awaitable returned by next(), completing with the next value written to the channel.
+    ///
+    class NextAwaitable final : public ChannelLoop::Waiter
+    {
+    public:
+        bool await_ready() { return check(); }                                         ///< Complete at once if new data is available.
+        void await_suspend(std::coroutine_handle<> handle) { loop_->watch(*this, handle); } ///< Hand the coroutine to the loop.
+        T await_resume() { return std::move(value_); }                                  ///< The value read from the channel.
+
+    protected:
+        bool poll() override { return channel_->takeNewData(value_); }
+
+    private:
+        friend class SharedMemory;
+        NextAwaitable(const SharedMemory *channel, ChannelLoop &loop)
+            : Waiter(channel->shared_data_->event), channel_(channel), loop_(&loop) {}
+
+        const SharedMemory *channel_; ///< Channel to read from.
+        ChannelLoop *loop_;           ///< Loop resuming the coroutine.
+        T value_{};                   ///< Value read from the channel.
+    };
+
+    /// @brief Read the next value from a coroutine without blocking the thread: `T value = co_await channel.next(loop);`
+    /// The coroutine is resumed by the loop once a writer in any process publishes new data.
+    /// @param loop The loop driving the coroutine.
+    /// @return An awaitable completing with the new data.
+    /// @throws std::runtime_error if shared_data_ is nullptr.
+    ///
+    NextAwaitable next(ChannelLoop &loop) const;
+
+    /// @brief Get the time between a write and the read consuming it.
+    /// Recorded only if the channel was created with options.latency_stats.
+    /// @return The percentiles in nanoseconds, over every process using the channel.
+    /// @throws std::runtime_error if shared_data_ is nullptr.
+    ///
+    LatencyStats latency() const;
+
+    /// @brief Get the time between two consecutive writes.
+    /// Recorded only if the channel was created with options.latency_stats.
+    /// @return The percentiles in nanoseconds, over every process using the channel.
+    /// @throws std::runtime_error if shared_data_ is nullptr.
+    ///
+    LatencyStats inter_arrival() const;
+
+    /// @brief Forget the recorded latencies and inter-arrival times.
+    /// @throws std::runtime_error if shared_data_ is nullptr.
+    ///
+    void reset_stats();
+
     /// @brief Set shared_data_ to nullptr for testing purposes.
     ///
     void setSharedDataNullptr()
@@ -58,22 +308,120 @@ public:
         shared_data_ = nullptr;
     }
 
+    /// @brief Tell whether the segment is backed by huge pages.
+    /// @return false if huge pages were not requested or not available.
+    ///
+    bool hugePages() const { return segment_.hugePages(); }
+
+    /// @brief Get the segment holding the shared data, e.g. to query its warm-up time.
+    /// @return The shared memory segment.
+    ///
+    const SharedSegment &segment() const { return segment_; }
+
 private:
     /// @brief Structure to hold shared data.
     ///
     struct SharedData
     {
-        SharedData() : new_data(false) {}                     ///< Default constructor
+        /// @brief The options readers and writers of the segment need, without the heap-owning ones.
+        struct Options
+        {
+            Notification notification; ///< How readers are woken up.
+            std::uint32_t spin_count;  ///< Futex only: iterations to spin before parking.
+            bool latency_stats;        ///< Whether writes and reads are timed.
+        };
+
+        explicit SharedData(const SharedMemoryOptions &opts)
+            : new_data(false), options{opts.notification, opts.spin_count, opts.latency_stats} {} ///< Constructor
         T data;                                               ///< The actual data stored in shared memory.
         bool new_data;                                        ///< Flag to indicate if new data is available.
+        std::uint64_t sequence{0U};                           ///< Number of writes so far, bumped with new_data.
+        std::int64_t publish_ns{0};                           ///< Steady clock time of the last write, with latency_stats.
+        Options options;                                      ///< Options the segment was created with.
         boost::interprocess::interprocess_mutex mutex;        ///< Mutex for synchronizing access.
         boost::interprocess::interprocess_condition cond_var; ///< Condition variable for synchronization
+        FutexEvent event;                                     ///< Futex word for Notification::Futex.
+        LatencyHistogram latency;                             ///< Stats block: time from write to consuming read.
+        LatencyHistogram inter_arrival;                       ///< Stats block: time between consecutive writes.
+
+        /// @brief Mark the data as new and stamp the write.
+        /// @pre mutex is held.
+        void publish()
+        {
+            new_data = true;
+            ++sequence;
+            if (options.latency_stats)
+            {
+                const auto now = LatencyHistogram::now();
+                if (publish_ns != 0)
+                {
+                    inter_arrival.record(static_cast<std::uint64_t>(now - publish_ns));
+                }
+                publish_ns = now;
+            }
+        }
+
+        /// @brief Mark the data as consumed and record its latency.
+        /// @pre mutex is held and new_data is set.
+        void consume()
+        {
+            new_data = false;
+            if (options.latency_stats)
+            {
+                latency.record(static_cast<std::uint64_t>(LatencyHistogram::now() - publish_ns));
+            }
+        }
+
+        /// @brief Wake the readers waiting for new data.
+        /// @pre new_data has been set.
+        void notifyReaders()
+        {
+            if (options.notification == Notification::Condition)
+            {
+                cond_var.notify_all();
+            }
+            // The futex word is bumped in both modes so that a ChannelLoop can watch it.
+            event.notify_all();
+        }
+
+        /// @brief Wait until new data is available.
+        /// @param lock A lock on mutex, held again when the function returns.
+        void waitForNewData(boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> &lock)
+        {
+            while (!new_data)
+            {
+                if (options.notification == Notification::Futex)
+                {
+                    const auto seen = event.value();
+                    lock.unlock();
+                    event.wait(seen, options.spin_count);
+                    lock.lock();
+                }
+                else
+                {
+                    cond_var.wait(lock);
+                }
+            }
+        }
     };
 
-    std::string name_;                              ///< Name of the shared memory object.
-    boost::interprocess::shared_memory_object shm_; ///< Shared memory object.
-    boost::interprocess::mapped_region region_;     ///< Mapped region of the shared memory.
-    SharedData *shared_data_;                       ///< Pointer to the shared data.
+    /// @brief Take new data without waiting for it.
+    /// @param out The object receiving the data.
+    /// @return false if no new data is available.
+    ///
+    bool takeNewData(T &out) const;
+
+    /// @brief Wait until new data is available or a deadline passes.
+    /// @param lock A lock on the shared mutex, held again when the function returns.
+    /// @param deadline The point in time after which to give up.
+    /// @return true if new data is available.
+    ///
+    bool waitForNewDataUntil(boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> &lock,
+                             std::chrono::steady_clock::time_point deadline) const;
+
+    SharedSegment segment_;                   ///< Shared memory segment holding the shared data.
+    SharedData *shared_data_;                 ///< Pointer to the shared data.
+    std::unique_ptr<EventFdPublisher> bridge_; ///< Eventfd bridge, nullptr unless options.eventfd_bridge is set.
 };
 
 #endif // GENERAL_INTER_P_LIB_SRC_SHARED_MEMORY_H
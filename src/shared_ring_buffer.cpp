@@ -0,0 +1,181 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "shared_ring_buffer.h"
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+/// Constructor to create or open the ring in shared memory.
+template <typename T>
+SharedRingBuffer<T>::SharedRingBuffer(const std::string &name, std::size_t capacity, const SegmentOptions &options)
+    : segment_(name, slotsOffset() + capacity * sizeof(T), options, layoutHash<ControlBlock>()),
+      control_(nullptr),
+      slots_(nullptr)
+{
+    assert(capacity > 0U && "Capacity must be greater than 0");
+    auto *base = static_cast<unsigned char *>(segment_.address());
+    slots_ = static_cast<T *>(static_cast<void *>(base + slotsOffset()));
+    if (!segment_.owner())
+    {
+        control_ = std::launder(static_cast<ControlBlock *>(segment_.address()));
+        return;
+    }
+
+    control_ = new (base) ControlBlock(capacity);
+    for (std::size_t i = 0U; i < capacity; ++i)
+    {
+        new (slots_ + i) T();
+    }
+    segment_.markInitialized();
+}
+
+/// Destructor
+template <typename T>
+SharedRingBuffer<T>::~SharedRingBuffer()
+{
+    if (!segment_.owner())
+    {
+        return;
+    }
+    for (std::size_t i = 0U; i < control_->capacity; ++i)
+    {
+        slots_[i].~T();
+    }
+    control_->~ControlBlock();
+}
+
+/// Append data to the ring
+template <typename T>
+typename SharedRingBuffer<T>::WriteStatus SharedRingBuffer<T>::write(const T &data)
+{
+    const auto head = control_->head.load(std::memory_order_relaxed);
+    if (head - control_->tail.load(std::memory_order_acquire) == control_->capacity)
+    {
+        return WriteStatus::Full;
+    }
+
+    slots_[head % control_->capacity] = data;
+    publish(head + 1U);
+    return WriteStatus::Success;
+}
+
+/// Append a batch of data to the ring
+template <typename T>
+std::size_t SharedRingBuffer<T>::write_batch(std::span<const T> data)
+{
+    const auto capacity = control_->capacity;
+    const auto head = control_->head.load(std::memory_order_relaxed);
+    const auto free = capacity - (head - control_->tail.load(std::memory_order_acquire));
+    const auto count = std::min(free, data.size());
+    if (count == 0U)
+    {
+        return 0U;
+    }
+
+    for (std::size_t i = 0U; i < count; ++i)
+    {
+        slots_[(head + i) % capacity] = data[i];
+    }
+    publish(head + count);
+    return count;
+}
+
+/// Read the oldest data, waiting if the ring is empty
+template <typename T>
+T SharedRingBuffer<T>::read()
+{
+    while (true)
+    {
+        if (auto data = pop())
+        {
+            return std::move(*data);
+        }
+        waitNotEmpty();
+    }
+}
+
+/// Drain a batch of data, waiting if the ring is empty
+template <typename T>
+std::size_t SharedRingBuffer<T>::read_batch(std::span<T> out, std::size_t max)
+{
+    assert(!out.empty() && max > 0U && "Batch must hold at least one item");
+    const auto capacity = control_->capacity;
+    const auto tail = control_->tail.load(std::memory_order_relaxed);
+    if (tail == control_->head.load(std::memory_order_acquire))
+    {
+        waitNotEmpty();
+    }
+
+    const auto available = control_->head.load(std::memory_order_acquire) - tail;
+    const auto count = std::min({available, max, out.size()});
+    for (std::size_t i = 0U; i < count; ++i)
+    {
+        out[i] = slots_[(tail + i) % capacity];
+    }
+    control_->tail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+/// Read the oldest data without blocking
+template <typename T>
+std::optional<T> SharedRingBuffer<T>::try_read()
+{
+    return pop();
+}
+
+/// Number of unread slots
+template <typename T>
+std::size_t SharedRingBuffer<T>::size() const
+{
+    const auto tail = control_->tail.load(std::memory_order_acquire);
+    return control_->head.load(std::memory_order_acquire) - tail;
+}
+
+/// Pop the oldest slot
+template <typename T>
+std::optional<T> SharedRingBuffer<T>::pop()
+{
+    const auto tail = control_->tail.load(std::memory_order_relaxed);
+    if (tail == control_->head.load(std::memory_order_acquire))
+    {
+        return std::nullopt;
+    }
+
+    std::optional<T> data(slots_[tail % control_->capacity]);
+    control_->tail.store(tail + 1U, std::memory_order_release);
+    return data;
+}
+
+/// Park the reader until the ring is not empty
+template <typename T>
+void SharedRingBuffer<T>::waitNotEmpty()
+{
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(control_->mutex);
+    control_->waiters.fetch_add(1U, std::memory_order_seq_cst);
+    while (control_->head.load(std::memory_order_seq_cst) == control_->tail.load(std::memory_order_relaxed))
+    {
+        control_->cond_var.wait(lock);
+    }
+    control_->waiters.fetch_sub(1U, std::memory_order_relaxed);
+}
+
+/// Publish a new head
+template <typename T>
+void SharedRingBuffer<T>::publish(std::size_t head)
+{
+    // Sequentially consistent so that the store of head and the load of waiters
+    // cannot be reordered against the reader's increment of waiters and load of head.
+    control_->head.store(head, std::memory_order_seq_cst);
+    if (control_->waiters.load(std::memory_order_seq_cst) != 0U)
+    {
+        boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(control_->mutex);
+        control_->cond_var.notify_all();
+    }
+}
+
+// Explicit template instantiation
+template class SharedRingBuffer<int>;
+template class SharedRingBuffer<std::uint32_t>;
+template class SharedRingBuffer<float>;
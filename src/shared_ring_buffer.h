@@ -0,0 +1,137 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the SharedRingBuffer class.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_SHARED_RING_BUFFER_H
+#define GENERAL_INTER_P_LIB_SRC_SHARED_RING_BUFFER_H
+
+#include "shared_segment.h"
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+
+/// @brief The SharedRingBuffer class template is a single-producer/single-consumer
+/// channel holding a fixed number of slots inside one shared memory segment.
+///
+/// Writes and reads only touch the atomic head and tail indices. The mutex and
+/// condition variable are used solely to park a reader on an empty ring, and the
+/// writer only takes the mutex when a reader is actually parked.
+///
+/// @tparam T template to allow different data types for the slots. The slots are read by
+/// other processes, so T must be trivially copyable; a type owning heap memory would leave
+/// pointers into the writer's heap in the segment. Pass such payloads through a flat layout,
+/// e.g. SharedFlatMemory, or as SharedFramePool indices.
+///
+/// @pre At most one process/thread writes and at most one process/thread reads.
+///
+template <typename T>
+class SharedRingBuffer
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SharedRingBuffer slots are shared between processes and must be trivially copyable");
+
+public:
+    /// @brief Enum to represent the status of a write operation.
+    ///
+    enum class WriteStatus
+    {
+        Success, ///< Indicates a successful write operation.
+        Full     ///< Indicates the ring was full and the data was not written.
+    };
+
+    /// @brief Constructor to create or attach to the ring in shared memory.
+    /// @param name The name of the shared memory object.
+    /// @param capacity The number of slots of the ring.
+    /// @param options The options of the segment, e.g. OpenMode::Attach for the consumer process.
+    ///
+    /// @pre capacity > 0.
+    ///
+    SharedRingBuffer(const std::string &name, std::size_t capacity, const SegmentOptions &options = {});
+
+    /// @brief Destructor to clean up shared memory.
+    ///
+    ~SharedRingBuffer();
+
+    SharedRingBuffer(const SharedRingBuffer &) = delete;
+    SharedRingBuffer &operator=(const SharedRingBuffer &) = delete;
+
+    /// @brief Append data to the ring without blocking.
+    /// @param data The data to be written to the next free slot.
+    /// @return WriteStatus::Full if every slot still holds unread data.
+    ///
+    WriteStatus write(const T &data);
+
+    /// @brief Take the oldest unread data, waiting until the ring is not empty.
+    /// @return The data read from the ring.
+    ///
+    T read();
+
+    /// @brief Take the oldest unread data without blocking.
+    /// @return The data read from the ring, or std::nullopt if the ring is empty.
+    ///
+    std::optional<T> try_read();
+
+    /// @brief Append as many items as fit with a single index update and at most one wake-up.
+    /// @param data The items to be written, in order.
+    /// @return The number of items written, the leading part of data; 0 if the ring is full.
+    ///
+    std::size_t write_batch(std::span<const T> data);
+
+    /// @brief Drain up to max items with a single index update, waiting until at least one is available.
+    /// @param out The destination of the items, in order.
+    /// @param max The maximum number of items to read.
+    /// @return The number of items read into the leading part of out.
+    ///
+    /// @pre out is not empty and max > 0.
+    ///
+    std::size_t read_batch(std::span<T> out, std::size_t max);
+
+    /// @brief Get the number of unread slots.
+    /// @return The number of slots written but not yet read.
+    std::size_t size() const;
+
+    /// @brief Get the number of slots of the ring.
+    /// @return The capacity of the ring.
+    std::size_t capacity() const { return control_->capacity; }
+
+private:
+    static_assert(std::atomic<std::size_t>::is_always_lock_free, "Ring indices must be lock-free to be shared between processes");
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Waiter count must be lock-free to be shared between processes");
+
+    /// @brief Structure placed at the start of the segment, followed by the slots.
+    ///
+    struct ControlBlock
+    {
+        explicit ControlBlock(std::size_t slot_count) : capacity(slot_count) {}
+
+        alignas(kCacheLineSize) std::atomic<std::size_t> head{0U};      ///< Index of the next slot to write, owned by the writer.
+        alignas(kCacheLineSize) std::atomic<std::size_t> tail{0U};      ///< Index of the next slot to read, owned by the reader.
+        alignas(kCacheLineSize) std::atomic<std::uint32_t> waiters{0U}; ///< Number of readers parked on cond_var.
+        std::size_t capacity;                                           ///< Number of slots following the control block.
+        boost::interprocess::interprocess_mutex mutex;                  ///< Mutex protecting the parked readers.
+        boost::interprocess::interprocess_condition cond_var;           ///< Condition variable to wake parked readers.
+    };
+
+    /// @brief Offset of the first slot from the start of the segment.
+    static constexpr std::size_t slotsOffset() { return alignUp(sizeof(ControlBlock), alignof(T)); }
+
+    /// @brief Pop the oldest slot if any.
+    std::optional<T> pop();
+
+    /// @brief Park the reader until the ring is not empty.
+    void waitNotEmpty();
+
+    /// @brief Publish a new head and wake the parked reader, if any.
+    void publish(std::size_t head);
+
+    SharedSegment segment_; ///< Shared memory segment holding the ring.
+    ControlBlock *control_; ///< Pointer to the control block.
+    T *slots_;              ///< Pointer to the first slot.
+};
+
+#endif // GENERAL_INTER_P_LIB_SRC_SHARED_RING_BUFFER_H
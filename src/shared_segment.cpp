@@ -0,0 +1,227 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "shared_segment.h"
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+/// Constructor to create or attach to the segment and map it.
+SharedSegment::SharedSegment(const std::string &name, std::size_t size, const SegmentOptions &options, std::uint64_t layout_hash)
+    : name_(name),
+      shm_(),
+      region_(),
+      huge_page_path_(),
+      base_(nullptr),
+      mapped_size_(0U),
+      owner_(options.open_mode == OpenMode::Create),
+      pages_locked_(false),
+      warm_up_time_(0)
+{
+    const auto deadline = std::chrono::steady_clock::now() + options.attach_timeout;
+    if (options.backing != SegmentBacking::HugePages || !mapHugePages(options.huge_page_mount, kHeaderSize + size, !owner_))
+    {
+        try
+        {
+            if (owner_)
+            {
+                shm_ = boost::interprocess::shared_memory_object(boost::interprocess::open_or_create, name.c_str(), boost::interprocess::read_write);
+                shm_.truncate(static_cast<boost::interprocess::offset_t>(kHeaderSize + size));
+            }
+            else
+            {
+                shm_ = boost::interprocess::shared_memory_object(boost::interprocess::open_only, name.c_str(), boost::interprocess::read_write);
+            }
+        }
+        catch (const boost::interprocess::interprocess_exception &)
+        {
+            throw std::runtime_error("Cannot open shared memory segment " + name);
+        }
+        mapSharedMemory(deadline);
+    }
+
+    if (owner_)
+    {
+        // Readers that attach while the channel state is being reset see magic == 0 and wait.
+        auto *header = new (base_) Header();
+        header->version = kLayoutVersion;
+        header->payload_size = size;
+        header->layout_hash = layout_hash;
+    }
+    else
+    {
+        checkHeader(size, layout_hash, deadline);
+    }
+    warmUp(options);
+}
+
+/// Destructor
+SharedSegment::~SharedSegment()
+{
+    if (pages_locked_)
+    {
+        munlock(base_, mapped_size_);
+    }
+    if (hugePages())
+    {
+        munmap(base_, mapped_size_);
+        if (owner_)
+        {
+            unlink(huge_page_path_.c_str());
+        }
+    }
+    else if (owner_)
+    {
+        boost::interprocess::shared_memory_object::remove(name_.c_str());
+    }
+}
+
+/// Publish the header
+void SharedSegment::markInitialized()
+{
+    if (owner_)
+    {
+        static_cast<Header *>(base_)->magic.store(kMagic, std::memory_order_release);
+    }
+}
+
+/// Map the shared memory object
+void SharedSegment::mapSharedMemory(std::chrono::steady_clock::time_point deadline)
+{
+    while (true)
+    {
+        try
+        {
+            // The creator may not have truncated the object yet: an empty object cannot be mapped.
+            boost::interprocess::offset_t object_size = 0;
+            if (shm_.get_size(object_size) && static_cast<std::size_t>(object_size) >= kHeaderSize)
+            {
+                region_ = boost::interprocess::mapped_region(shm_, boost::interprocess::read_write);
+                base_ = region_.get_address();
+                mapped_size_ = region_.get_size();
+                return;
+            }
+        }
+        catch (const boost::interprocess::interprocess_exception &)
+        {
+            // Retried until the deadline, as for an empty object.
+        }
+        if (owner_ || std::chrono::steady_clock::now() >= deadline)
+        {
+            throw std::runtime_error("Cannot map shared memory segment " + name_);
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+/// Map a file of the hugetlbfs mount
+bool SharedSegment::mapHugePages(const std::string &mount, std::size_t size, bool attach)
+{
+    const auto path = mount + "/" + name_;
+    const int fd = attach ? open(path.c_str(), O_RDWR) : open(path.c_str(), O_CREAT | O_RDWR, 0666);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    // hugetlbfs only maps whole huge pages, and fails here if none are reserved.
+    auto rounded = alignUp(size, kHugePageSize);
+    void *address = MAP_FAILED;
+    struct stat status
+    {
+    };
+    if (attach && fstat(fd, &status) == 0)
+    {
+        rounded = static_cast<std::size_t>(status.st_size);
+        address = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    else if (!attach && ftruncate(fd, static_cast<off_t>(rounded)) == 0)
+    {
+        address = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (address == MAP_FAILED)
+    {
+        if (!attach)
+        {
+            unlink(path.c_str());
+        }
+        return false;
+    }
+
+    huge_page_path_ = path;
+    base_ = address;
+    mapped_size_ = rounded;
+    return true;
+}
+
+/// Check the header of an attached segment
+void SharedSegment::checkHeader(std::size_t size, std::uint64_t layout_hash, std::chrono::steady_clock::time_point deadline) const
+{
+    if (mapped_size_ < kHeaderSize)
+    {
+        throw std::runtime_error("Shared memory segment " + name_ + " has no header");
+    }
+
+    const auto *header = static_cast<const Header *>(base_);
+    while (header->magic.load(std::memory_order_acquire) != kMagic)
+    {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            throw std::runtime_error("Shared memory segment " + name_ + " was not initialized in time");
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    if (header->version != kLayoutVersion)
+    {
+        throw std::runtime_error("Shared memory segment " + name_ + " has an incompatible layout version");
+    }
+    if (header->payload_size != size || mapped_size_ < kHeaderSize + size)
+    {
+        throw std::runtime_error("Shared memory segment " + name_ + " has a different payload size");
+    }
+    if (header->layout_hash != layout_hash)
+    {
+        throw std::runtime_error("Shared memory segment " + name_ + " holds a different payload type");
+    }
+}
+
+/// Pre-fault and lock the mapping
+void SharedSegment::warmUp(const SegmentOptions &options)
+{
+    if (!options.prefault && !options.lock_pages)
+    {
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    if (options.prefault)
+    {
+#if defined(MADV_POPULATE_WRITE)
+        const bool populated = madvise(base_, mapped_size_, MADV_POPULATE_WRITE) == 0;
+#else
+        const bool populated = false;
+#endif
+        if (!populated)
+        {
+            // Fault each page in for writing without changing its content, which
+            // another process may already be using.
+            const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            auto *base = static_cast<unsigned char *>(base_);
+            for (std::size_t offset = 0U; offset < mapped_size_; offset += page_size)
+            {
+                std::atomic_ref<unsigned char>(base[offset]).fetch_or(0U, std::memory_order_relaxed);
+            }
+        }
+    }
+    if (options.lock_pages)
+    {
+        pages_locked_ = mlock(base_, mapped_size_) == 0;
+    }
+    warm_up_time_ = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+}
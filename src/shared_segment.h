@@ -0,0 +1,188 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the SharedSegment class.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_SHARED_SEGMENT_H
+#define GENERAL_INTER_P_LIB_SRC_SHARED_SEGMENT_H
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <typeinfo>
+
+/// @brief Size of a cache line, used to keep producer and consumer indices
+/// of the lock-free channels on separate lines.
+///
+inline constexpr std::size_t kCacheLineSize = 64U;
+
+/// @brief Size of a huge page on x86-64 and aarch64 with 4 KB base pages.
+///
+inline constexpr std::size_t kHugePageSize = 2U * 1024U * 1024U;
+
+/// @brief Memory backing a shared segment.
+///
+enum class SegmentBacking
+{
+    SharedMemory, ///< POSIX shared memory object (/dev/shm), 4 KB pages.
+    HugePages     ///< File on a hugetlbfs mount, 2 MB pages; falls back to SharedMemory if none are reserved.
+};
+
+/// @brief How a channel gets hold of its shared segment.
+///
+enum class OpenMode
+{
+    Create, ///< Create the segment, or re-initialize a leftover one of the same name; removed on destruction.
+    Attach  ///< Attach to a segment initialized by another process without resetting it; left in place on destruction.
+};
+
+/// @brief Options of a shared segment, fixed at construction.
+/// Every process attached to a segment must use the same options.
+///
+struct SegmentOptions
+{
+    OpenMode open_mode = OpenMode::Create;                 ///< Create or attach to the segment.
+    std::chrono::milliseconds attach_timeout{1000};        ///< Attach only: how long to wait for the creator to finish initializing.
+    SegmentBacking backing = SegmentBacking::SharedMemory; ///< Memory backing the segment.
+    std::string huge_page_mount = "/dev/hugepages";        ///< HugePages only: hugetlbfs mount holding the segment files.
+    bool prefault = false;                                 ///< Fault every page in at construction instead of on first access.
+    bool lock_pages = false;                               ///< mlock the mapping so that it cannot be paged out.
+};
+
+/// @brief The SharedSegment class owns a named shared memory object and its mapping
+/// into the current process.
+/// It is the common backing store of the shared memory channels.
+///
+/// Every segment starts with a versioned header holding a magic number, the layout
+/// version, the payload size and a hash of the payload type. The creator publishes
+/// the header once the channel state is constructed, and an attaching process checks
+/// it before using the payload.
+///
+class SharedSegment final
+{
+public:
+    /// @brief Create or attach to a shared memory segment and map it.
+    /// @param name The name of the shared memory object.
+    /// @param size The size of the payload in bytes.
+    /// @param options The options of the segment, e.g. its open mode and backing.
+    /// @param layout_hash Hash of the payload layout, see layoutHash().
+    /// @throws std::runtime_error if attaching to a segment that is missing, not initialized in time,
+    /// or whose header does not match.
+    ///
+    SharedSegment(const std::string &name, std::size_t size, const SegmentOptions &options = {}, std::uint64_t layout_hash = 0U);
+
+    /// @brief Unmap the segment, and remove the shared memory object if this process created it.
+    ///
+    ~SharedSegment();
+
+    SharedSegment(const SharedSegment &) = delete;
+    SharedSegment &operator=(const SharedSegment &) = delete;
+
+    /// @brief Get the address of the payload, right after the header.
+    /// @return The address of the first byte of the payload, aligned to a cache line.
+    void *address() const { return static_cast<unsigned char *>(base_) + kHeaderSize; }
+
+    /// @brief Get the size of the payload.
+    /// @return The size of the payload in bytes, rounded up to the page size.
+    std::size_t size() const { return mapped_size_ - kHeaderSize; }
+
+    /// @brief Tell whether this process created the segment.
+    /// Only the creator constructs the channel state in the payload and destroys it.
+    /// @return true for OpenMode::Create.
+    bool owner() const { return owner_; }
+
+    /// @brief Publish the header so that other processes can attach.
+    /// To be called by the creator once the channel state is constructed; no-op when attached.
+    ///
+    void markInitialized();
+
+    /// @brief Get the name of the shared memory object.
+    /// @return The name of the shared memory object.
+    const std::string &name() const { return name_; }
+
+    /// @brief Tell whether the segment is backed by huge pages.
+    /// @return false if SegmentBacking::SharedMemory was requested or huge pages were not available.
+    bool hugePages() const { return !huge_page_path_.empty(); }
+
+    /// @brief Tell whether the mapping is locked in memory.
+    /// @return false if locking was not requested or was refused, e.g. by RLIMIT_MEMLOCK.
+    bool pagesLocked() const { return pages_locked_; }
+
+    /// @brief Get the time spent pre-faulting and locking the mapping at construction.
+    /// @return The warm-up duration, zero if neither was requested.
+    std::chrono::nanoseconds warmUpTime() const { return warm_up_time_; }
+
+private:
+    /// @brief Versioned header at the start of every segment.
+    ///
+    struct Header
+    {
+        std::atomic<std::uint64_t> magic{0U}; ///< kMagic once the creator finished initializing, written last.
+        std::uint32_t version{0U};            ///< Layout version of the header and the channels.
+        std::uint64_t payload_size{0U};       ///< Payload size requested by the creator.
+        std::uint64_t layout_hash{0U};        ///< Hash of the payload layout.
+    };
+
+    static constexpr std::uint64_t kMagic = 0x314D485350494C47U; ///< "GILPSHM1" in little-endian.
+    static constexpr std::uint32_t kLayoutVersion = 1U;          ///< Bumped whenever a channel layout changes.
+    static constexpr std::size_t kHeaderSize = kCacheLineSize;   ///< Space reserved for the header.
+    static_assert(sizeof(Header) <= kHeaderSize, "Segment header must fit into its reserved space");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Segment magic must be lock-free to be shared between processes");
+
+    /// @brief Map the shared memory object, waiting until the deadline for the creator to size it when attaching.
+    /// @throws std::runtime_error if the object cannot be mapped in time.
+    void mapSharedMemory(std::chrono::steady_clock::time_point deadline);
+
+    /// @brief Map a file of the hugetlbfs mount.
+    /// @return true on success, false if the mount, the file or the reserved huge pages are missing.
+    bool mapHugePages(const std::string &mount, std::size_t size, bool attach);
+
+    /// @brief Check the header of a segment initialized by another process.
+    void checkHeader(std::size_t size, std::uint64_t layout_hash, std::chrono::steady_clock::time_point deadline) const;
+
+    /// @brief Pre-fault and lock the mapping as requested by the options.
+    void warmUp(const SegmentOptions &options);
+
+    std::string name_;                              ///< Name of the shared memory object.
+    boost::interprocess::shared_memory_object shm_; ///< Shared memory object, SegmentBacking::SharedMemory only.
+    boost::interprocess::mapped_region region_;     ///< Mapped region of the shared memory object.
+    std::string huge_page_path_;                    ///< Path of the hugetlbfs file, empty if not backed by huge pages.
+    void *base_;                                    ///< Address of the mapping, i.e. of the header.
+    std::size_t mapped_size_;                       ///< Size of the mapping in bytes.
+    bool owner_;                                    ///< Whether this process created the segment.
+    bool pages_locked_;                             ///< Whether the mapping is locked in memory.
+    std::chrono::nanoseconds warm_up_time_;         ///< Time spent pre-faulting and locking.
+};
+
+/// @brief Round an offset up to the next multiple of an alignment.
+/// @param offset The offset to round up.
+/// @param alignment The alignment, must be a power of two.
+/// @return The aligned offset.
+///
+constexpr std::size_t alignUp(std::size_t offset, std::size_t alignment)
+{
+    return (offset + alignment - 1U) & ~(alignment - 1U);
+}
+
+/// @brief Hash identifying the layout of a type placed in a segment.
+/// It is derived from the mangled type name and the size, so it matches between
+/// processes built with the same compiler and differs between channel types.
+/// @tparam T The type placed at the start of the payload, usually the channel control block.
+/// @return The FNV-1a hash of the type name, mixed with its size.
+///
+template <typename T>
+std::uint64_t layoutHash()
+{
+    std::uint64_t hash = 14695981039346656037U;
+    for (const char *c = typeid(T).name(); *c != '\0'; ++c)
+    {
+        hash ^= static_cast<unsigned char>(*c);
+        hash *= 1099511628211U;
+    }
+    return hash ^ sizeof(T);
+}
+
+#endif // GENERAL_INTER_P_LIB_SRC_SHARED_SEGMENT_H
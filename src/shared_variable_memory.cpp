@@ -0,0 +1,144 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+
+#include "shared_variable_memory.h"
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+/// Constructor to create or open the channel.
+template <typename T>
+SharedVariableMemory<T>::SharedVariableMemory(const std::string &name, std::size_t segment_size, const SegmentOptions &options)
+    : segment_(name, segment_size, options, layoutHash<SharedData>()), buffer_(), shared_data_(nullptr)
+{
+    if (segment_.owner())
+    {
+        // A segment left over by a crashed run is formatted again, so no stale lock survives.
+        buffer_ = boost::interprocess::managed_external_buffer(boost::interprocess::create_only, segment_.address(), segment_size);
+        shared_data_ = buffer_.construct<SharedData>("SharedData")(buffer_.get_segment_manager());
+        segment_.markInitialized();
+        return;
+    }
+
+    buffer_ = boost::interprocess::managed_external_buffer(boost::interprocess::open_only, segment_.address(), segment_size);
+    shared_data_ = buffer_.find<SharedData>("SharedData").first;
+    if (shared_data_ == nullptr)
+    {
+        throw std::runtime_error("Shared memory segment " + name + " holds no payload");
+    }
+}
+
+/// Destructor
+template <typename T>
+SharedVariableMemory<T>::~SharedVariableMemory()
+{
+    if (segment_.owner())
+    {
+        // The segment removes the shared memory object.
+        buffer_.destroy_ptr(shared_data_);
+    }
+}
+
+/// Write a sequence of elements to shared memory
+template <typename T>
+typename SharedVariableMemory<T>::WriteStatus SharedVariableMemory<T>::write(std::span<const T> data)
+{
+    return assign(data, data.size(), 1U, 1U);
+}
+
+/// Write an image to shared memory
+template <typename T>
+typename SharedVariableMemory<T>::WriteStatus SharedVariableMemory<T>::write(const Image<T> &image)
+{
+    return assign(image.readData(), image.width(), image.height(), image.num_channels());
+}
+
+/// Read the payload from shared memory
+template <typename T>
+std::vector<T> SharedVariableMemory<T>::read() const
+{
+    const auto loan = acquire_read_slot();
+    const auto data = loan->readData();
+    return std::vector<T>(data.begin(), data.end());
+}
+
+/// Read the payload as an image
+template <typename T>
+Image<T> SharedVariableMemory<T>::read_image() const
+{
+    const auto loan = acquire_read_slot();
+    const auto data = loan->readData();
+    return Image<T>(std::vector<T>(data.begin(), data.end()), loan->width(), loan->height(), loan->num_channels());
+}
+
+/// Loan the payload for writing
+template <typename T>
+typename SharedVariableMemory<T>::WriteLoan SharedVariableMemory<T>::acquire_write_slot(std::size_t width, std::size_t height, std::size_t num_channels)
+{
+    const auto count = width * height * num_channels;
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+    try
+    {
+        // Same as resize(count), which trips -Wnull-dereference inside Boost.Container at -O2.
+        auto &payload = shared_data_->payload;
+        if (count < payload.size())
+        {
+            payload.erase(payload.begin() + static_cast<std::ptrdiff_t>(count), payload.end());
+        }
+        else
+        {
+            payload.insert(payload.end(), count - payload.size(), T{});
+        }
+    }
+    catch (const boost::interprocess::bad_alloc &)
+    {
+        throw std::length_error("Payload does not fit into the shared memory segment");
+    }
+    lock.release();
+    return WriteLoan(shared_data_, ImageView<T>(std::span<T>(shared_data_->payload.data(), count), width, height, num_channels));
+}
+
+/// Loan the payload for reading
+template <typename T>
+typename SharedVariableMemory<T>::ReadLoan SharedVariableMemory<T>::acquire_read_slot() const
+{
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+    while (!shared_data_->new_data)
+    {
+        shared_data_->cond_var.wait(lock);
+    }
+    lock.release();
+    const auto count = shared_data_->width * shared_data_->height * shared_data_->num_channels;
+    return ReadLoan(shared_data_, ImageView<const T>(std::span<const T>(shared_data_->payload.data(), count),
+                                                     shared_data_->width, shared_data_->height, shared_data_->num_channels));
+}
+
+/// Copy elements into the payload
+template <typename T>
+typename SharedVariableMemory<T>::WriteStatus SharedVariableMemory<T>::assign(std::span<const T> data, std::size_t width,
+                                                                              std::size_t height, std::size_t num_channels)
+{
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock(shared_data_->mutex);
+    try
+    {
+        // assign() reuses the capacity of the payload and only allocates when it grows.
+        shared_data_->payload.assign(data.begin(), data.end());
+    }
+    catch (const boost::interprocess::bad_alloc &)
+    {
+        return WriteStatus::Failure;
+    }
+    shared_data_->width = width;
+    shared_data_->height = height;
+    shared_data_->num_channels = num_channels;
+    shared_data_->new_data = true;
+    shared_data_->cond_var.notify_all();
+    return WriteStatus::Success;
+}
+
+// Explicit template instantiation
+template class SharedVariableMemory<float>;
+template class SharedVariableMemory<std::uint8_t>;
+template class SharedVariableMemory<std::size_t>;
@@ -0,0 +1,219 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the SharedVariableMemory class.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_SHARED_VARIABLE_MEMORY_H
+#define GENERAL_INTER_P_LIB_SRC_SHARED_VARIABLE_MEMORY_H
+
+#include "image.h"
+#include "shared_segment.h"
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/containers/vector.hpp>
+#include <boost/interprocess/managed_external_buffer.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+/// @brief The SharedVariableMemory class template shares a payload whose size changes
+/// from one write to the next, e.g. images of varying resolution or vectors of varying length.
+///
+/// The payload area of a SharedSegment is managed as a boost::interprocess::managed_external_buffer:
+/// the payload is a boost::interprocess::vector allocated by the segment manager and addressed
+/// through offset_ptr, so every process reads it in place whatever address the segment is mapped at.
+/// The payload keeps its capacity, so writes only allocate when it grows.
+///
+/// @tparam T template to allow different data types for the payload elements.
+///
+template <typename T>
+class SharedVariableMemory
+{
+private:
+    struct SharedData;
+
+public:
+    /// @brief Enum to represent the status of a write operation.
+    ///
+    enum class WriteStatus
+    {
+        Success, ///< Indicates a successful write operation.
+        Failure  ///< Indicates a failed write operation, e.g. a payload the segment has no room for.
+    };
+
+    /// @brief Constructor to create or attach to the channel.
+    /// @param name The name of the shared memory object.
+    /// @param segment_size The size of the managed segment in bytes, bounding the largest payload.
+    /// @param options The options of the segment, e.g. OpenMode::Attach for reader processes.
+    /// @throws std::runtime_error if attaching to a missing or incompatible segment.
+    ///
+    SharedVariableMemory(const std::string &name, std::size_t segment_size, const SegmentOptions &options = {});
+
+    /// @brief Destructor to clean up shared memory.
+    ///
+    ~SharedVariableMemory();
+
+    SharedVariableMemory(const SharedVariableMemory &) = delete;
+    SharedVariableMemory &operator=(const SharedVariableMemory &) = delete;
+
+    /// @brief Copy a sequence of elements into shared memory, as a width x 1 x 1 image.
+    /// @param data The elements to be written.
+    /// @return WriteStatus::Failure if the segment has no room for the payload.
+    ///
+    WriteStatus write(std::span<const T> data);
+
+    /// @brief Copy an image into shared memory, keeping its shape.
+    /// @param image The image to be written.
+    /// @return WriteStatus::Failure if the segment has no room for the payload.
+    ///
+    WriteStatus write(const Image<T> &image);
+
+    /// @brief Read the payload, waiting for new data.
+    /// @return A copy of the elements held in shared memory.
+    ///
+    std::vector<T> read() const;
+
+    /// @brief Read the payload as an image, waiting for new data.
+    /// @return A copy of the image held in shared memory.
+    ///
+    Image<T> read_image() const;
+
+    /// @brief Writable view of the payload, loaned to the producer.
+    /// The shared mutex is held for the lifetime of the loan.
+    ///
+    class WriteLoan
+    {
+    public:
+        WriteLoan(WriteLoan &&other) noexcept : shared_data_(other.shared_data_), view_(other.view_) { other.shared_data_ = nullptr; }
+        WriteLoan(const WriteLoan &) = delete;
+        WriteLoan &operator=(const WriteLoan &) = delete;
+        WriteLoan &operator=(WriteLoan &&) = delete;
+
+        ~WriteLoan()
+        {
+            if (shared_data_)
+            {
+                shared_data_->mutex.unlock();
+            }
+        }
+
+        /// @brief Access the payload in shared memory.
+        /// @pre The loan has not been committed.
+        const ImageView<T> &operator*() const { return view_; }
+        const ImageView<T> *operator->() const { return &view_; }
+
+        /// @brief Publish the payload to the readers and give it back.
+        /// @return WriteStatus::Failure if the loan was already committed.
+        ///
+        WriteStatus commit()
+        {
+            if (!shared_data_)
+            {
+                return WriteStatus::Failure;
+            }
+            shared_data_->width = view_.width();
+            shared_data_->height = view_.height();
+            shared_data_->num_channels = view_.num_channels();
+            shared_data_->new_data = true;
+            shared_data_->mutex.unlock();
+            shared_data_->cond_var.notify_all();
+            shared_data_ = nullptr;
+            return WriteStatus::Success;
+        }
+
+    private:
+        friend class SharedVariableMemory;
+        WriteLoan(SharedData *shared_data, ImageView<T> view) : shared_data_(shared_data), view_(view) {}
+
+        SharedData *shared_data_; ///< Loaned shared data, nullptr once committed.
+        ImageView<T> view_;       ///< View of the payload in shared memory.
+    };
+
+    /// @brief Read-only view of the payload, loaned to the consumer.
+    /// The payload stays valid until release() is called or the loan is destroyed.
+    ///
+    class ReadLoan
+    {
+    public:
+        ReadLoan(ReadLoan &&other) noexcept : shared_data_(other.shared_data_), view_(other.view_) { other.shared_data_ = nullptr; }
+        ReadLoan(const ReadLoan &) = delete;
+        ReadLoan &operator=(const ReadLoan &) = delete;
+        ReadLoan &operator=(ReadLoan &&) = delete;
+
+        ~ReadLoan() { release(); }
+
+        /// @brief Access the payload in shared memory.
+        /// @pre The loan has not been released.
+        const ImageView<const T> &operator*() const { return view_; }
+        const ImageView<const T> *operator->() const { return &view_; }
+
+        /// @brief Mark the payload as consumed and give it back to the writer.
+        ///
+        void release()
+        {
+            if (shared_data_)
+            {
+                shared_data_->new_data = false;
+                shared_data_->mutex.unlock();
+                shared_data_ = nullptr;
+            }
+        }
+
+    private:
+        friend class SharedVariableMemory;
+        ReadLoan(SharedData *shared_data, ImageView<const T> view) : shared_data_(shared_data), view_(view) {}
+
+        SharedData *shared_data_; ///< Loaned shared data, nullptr once released.
+        ImageView<const T> view_; ///< View of the payload in shared memory.
+    };
+
+    /// @brief Resize the payload to the given shape and loan it to the caller to fill in place.
+    /// @param width Width of the image, or number of elements.
+    /// @param height Height of the image.
+    /// @param num_channels Number of channels in the image.
+    /// @return A WriteLoan giving direct access to the payload in shared memory.
+    /// @throws std::length_error if the segment has no room for the payload.
+    ///
+    WriteLoan acquire_write_slot(std::size_t width, std::size_t height = 1, std::size_t num_channels = 1);
+
+    /// @brief Wait for a new payload and loan it to the caller.
+    /// @return A ReadLoan giving direct access to the payload in shared memory.
+    ///
+    ReadLoan acquire_read_slot() const;
+
+    /// @brief Get the number of bytes still available for payloads in the segment.
+    /// @return The free memory of the segment manager.
+    std::size_t free_memory() const { return buffer_.get_free_memory(); }
+
+    /// @brief Get the segment holding the payload.
+    /// @return The shared memory segment.
+    const SharedSegment &segment() const { return segment_; }
+
+private:
+    using SegmentManager = boost::interprocess::managed_external_buffer::segment_manager;
+    using Payload = boost::interprocess::vector<T, boost::interprocess::allocator<T, SegmentManager>>;
+
+    /// @brief Structure to hold shared data, constructed by the segment manager.
+    ///
+    struct SharedData
+    {
+        explicit SharedData(SegmentManager *manager) : payload(manager) {} ///< Constructor
+        bool new_data{false};                                 ///< Flag to indicate if new data is available.
+        std::size_t width{0U};                                ///< Width of the payload.
+        std::size_t height{0U};                               ///< Height of the payload.
+        std::size_t num_channels{0U};                         ///< Number of channels of the payload.
+        Payload payload;                                      ///< Elements allocated in the segment.
+        boost::interprocess::interprocess_mutex mutex;        ///< Mutex for synchronizing access.
+        boost::interprocess::interprocess_condition cond_var; ///< Condition variable for synchronization
+    };
+
+    /// @brief Copy elements into the payload and publish them with the given shape.
+    WriteStatus assign(std::span<const T> data, std::size_t width, std::size_t height, std::size_t num_channels);
+
+    SharedSegment segment_;                              ///< Shared memory segment holding the managed buffer.
+    boost::interprocess::managed_external_buffer buffer_; ///< Segment manager over the payload area of the segment.
+    SharedData *shared_data_;                            ///< Pointer to the shared data.
+};
+
+#endif // GENERAL_INTER_P_LIB_SRC_SHARED_VARIABLE_MEMORY_H
@@ -0,0 +1,192 @@
+/// @file
+/// @copyright (c) Jean Frantz René
+/// Interface of the shm_traits customization point.
+
+#ifndef GENERAL_INTER_P_LIB_SRC_SHM_TRAITS_H
+#define GENERAL_INTER_P_LIB_SRC_SHM_TRAITS_H
+
+#include "copy_kernel.h"
+#include "image.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/// @brief Flat, pointer-free layout of a type in shared memory, used by the channels that
+/// copy a value into a byte buffer, e.g. SharedFlatMemory and ChannelRecorder.
+///
+/// A specialization provides:
+/// - `view_type`, a read-only view over the flat bytes;
+/// - `static constexpr std::size_t alignment`, the alignment the flat bytes need for view();
+/// - `static std::size_t flat_size(const T &value)`, the number of bytes of the flat layout;
+/// - `static void serialize(const T &value, std::span<unsigned char> out)`, with out.size() == flat_size(value);
+/// - `static view_type view(std::span<const unsigned char> in)`, in aligned to alignment;
+/// - `static void deserialize(std::span<const unsigned char> in, T &out)`.
+///
+/// view() and deserialize() throw std::runtime_error when in is shorter than the layout it
+/// describes, e.g. a truncated or corrupted record.
+///
+/// Specializations are provided for trivially copyable types, std::array, std::vector and Image
+/// of trivially copyable elements. Any other type, e.g. one owning heap memory, is rejected at
+/// compile time until shm_traits is specialized for it.
+///
+/// @tparam T The type to lay out.
+///
+template <typename T>
+struct shm_traits
+{
+    static_assert(!std::is_same_v<T, T>, "T has no flat shared memory layout: it is not trivially copyable, "
+                                         "so it may own heap memory. Specialize shm_traits<T> for it.");
+};
+
+/// @brief Check that a specialization of shm_traits provides the whole interface.
+/// For a type without one, the static_assert of the primary template fires instead.
+///
+template <typename T>
+concept ShmSerializable = requires(const T &value, T &out, std::span<unsigned char> bytes, std::span<const unsigned char> in) {
+    typename shm_traits<T>::view_type;
+    { shm_traits<T>::flat_size(value) } -> std::convertible_to<std::size_t>;
+    shm_traits<T>::serialize(value, bytes);
+    shm_traits<T>::view(in);
+    shm_traits<T>::deserialize(in, out);
+};
+
+/// @brief Layout of a trivially copyable type: its object representation.
+///
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+struct shm_traits<T>
+{
+    using view_type = const T &;
+    static constexpr std::size_t alignment = alignof(T);
+
+    static std::size_t flat_size(const T &) { return sizeof(T); }
+    static void serialize(const T &value, std::span<unsigned char> out) { copyBytes(out.data(), &value, sizeof(T)); }
+    static view_type view(std::span<const unsigned char> in)
+    {
+        check(in);
+        return *std::launder(static_cast<const T *>(static_cast<const void *>(in.data())));
+    }
+    static void deserialize(std::span<const unsigned char> in, T &out)
+    {
+        check(in);
+        copyBytes(&out, in.data(), sizeof(T));
+    }
+
+private:
+    static void check(std::span<const unsigned char> in)
+    {
+        if (in.size() < sizeof(T))
+        {
+            throw std::runtime_error("Flat layout is shorter than the value");
+        }
+    }
+};
+
+/// @brief Layout of an array: its elements, viewed as a fixed-size span.
+///
+template <typename E, std::size_t N>
+struct shm_traits<std::array<E, N>>
+{
+    static_assert(std::is_trivially_copyable_v<E>, "Array elements have no flat shared memory layout");
+
+    using view_type = std::span<const E, N>;
+    static constexpr std::size_t alignment = alignof(E);
+
+    static std::size_t flat_size(const std::array<E, N> &) { return N * sizeof(E); }
+    static void serialize(const std::array<E, N> &value, std::span<unsigned char> out) { copyBytes(out.data(), value.data(), N * sizeof(E)); }
+    static view_type view(std::span<const unsigned char> in)
+    {
+        check(in);
+        return view_type(static_cast<const E *>(static_cast<const void *>(in.data())), N);
+    }
+    static void deserialize(std::span<const unsigned char> in, std::array<E, N> &out)
+    {
+        check(in);
+        copyBytes(out.data(), in.data(), N * sizeof(E));
+    }
+
+private:
+    static void check(std::span<const unsigned char> in)
+    {
+        if (in.size() < N * sizeof(E))
+        {
+            throw std::runtime_error("Flat layout is shorter than the array");
+        }
+    }
+};
+
+/// @brief Layout of a vector: its elements, the count following from the number of bytes.
+///
+template <typename E>
+struct shm_traits<std::vector<E>>
+{
+    static_assert(std::is_trivially_copyable_v<E>, "Vector elements have no flat shared memory layout");
+
+    using view_type = std::span<const E>;
+    static constexpr std::size_t alignment = alignof(E);
+
+    static std::size_t flat_size(const std::vector<E> &value) { return value.size() * sizeof(E); }
+    static void serialize(const std::vector<E> &value, std::span<unsigned char> out) { copyElements(value.data(), value.size(), static_cast<E *>(static_cast<void *>(out.data()))); }
+    static view_type view(std::span<const unsigned char> in) { return view_type(static_cast<const E *>(static_cast<const void *>(in.data())), in.size() / sizeof(E)); }
+    static void deserialize(std::span<const unsigned char> in, std::vector<E> &out)
+    {
+        out.resize(in.size() / sizeof(E));
+        copyElements(static_cast<const E *>(static_cast<const void *>(in.data())), out.size(), out.data());
+    }
+};
+
+/// @brief Layout of an image: width, height and number of channels as 64-bit values, then the pixels.
+///
+template <typename E>
+struct shm_traits<Image<E>>
+{
+    static_assert(std::is_trivially_copyable_v<E>, "Image pixels have no flat shared memory layout");
+
+    using view_type = ImageView<const E>;
+    static constexpr std::size_t alignment = std::max(alignof(std::uint64_t), alignof(E));
+    static constexpr std::size_t kShapeSize = (3U * sizeof(std::uint64_t) + alignof(E) - 1U) / alignof(E) * alignof(E); ///< Bytes before the pixels.
+
+    static std::size_t flat_size(const Image<E> &value) { return kShapeSize + value.readData().size() * sizeof(E); }
+    static void serialize(const Image<E> &value, std::span<unsigned char> out)
+    {
+        const std::uint64_t shape[3] = {value.width(), value.height(), value.num_channels()};
+        std::memcpy(out.data(), shape, sizeof(shape));
+        const auto pixels = value.readData();
+        copyElements(pixels.data(), pixels.size(), static_cast<E *>(static_cast<void *>(out.data() + kShapeSize)));
+    }
+    static view_type view(std::span<const unsigned char> in)
+    {
+        if (in.size() < kShapeSize)
+        {
+            throw std::runtime_error("Flat layout is shorter than the image shape");
+        }
+        std::uint64_t shape[3] = {};
+        std::memcpy(shape, in.data(), sizeof(shape));
+        const auto count = (in.size() - kShapeSize) / sizeof(E);
+        // Divide instead of multiplying the extents, which a corrupted shape could overflow.
+        if (shape[0] != 0U && shape[1] != 0U && shape[2] != 0U &&
+            (shape[0] > count || shape[1] > count / shape[0] || shape[2] > count / (shape[0] * shape[1])))
+        {
+            throw std::runtime_error("Flat layout is shorter than the image pixels");
+        }
+        const auto *pixels = static_cast<const E *>(static_cast<const void *>(in.data() + kShapeSize));
+        return view_type(std::span<const E>(pixels, count), shape[0], shape[1], shape[2]);
+    }
+    static void deserialize(std::span<const unsigned char> in, Image<E> &out)
+    {
+        // Copy into the pixel buffer of out, which only reallocates when the image grows.
+        const auto pixels = view(in);
+        out.reshape(pixels.width(), pixels.height(), pixels.num_channels());
+        copyElements(pixels.readData().data(), pixels.readData().size(), out.data().data());
+    }
+};
+
+#endif // GENERAL_INTER_P_LIB_SRC_SHM_TRAITS_H
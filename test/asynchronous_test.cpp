@@ -0,0 +1,95 @@
+/// @file
+/// @brief Unit tests for the AsyncSharedMemory class.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "asynchronous.h"
+
+// Test fixture for AsyncSharedMemory
+class AsyncSharedMemoryTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory object used in the tests.
+    ///
+    void TearDown() override
+    {
+        boost::interprocess::shared_memory_object::remove("AsyncSharedMemoryTest");
+    }
+};
+
+// A written frame is visible to readers once its handle is done
+TEST_F(AsyncSharedMemoryTest, WriteHandleCompletes)
+{
+    AsyncSharedMemory<int> async("AsyncSharedMemoryTest", sizeof(int));
+    const auto handle = async.write(42);
+    handle.wait();
+
+    EXPECT_TRUE(handle.done());
+    EXPECT_EQ(async.channel().read(), 42);
+    EXPECT_EQ(async.published(), 1U);
+}
+
+// KeepAll publishes every frame in order, blocking the writer when the queue is full
+TEST_F(AsyncSharedMemoryTest, KeepAllPublishesEveryFrame)
+{
+    AsyncSharedMemoryOptions options;
+    options.queue_capacity = 2U;
+    AsyncSharedMemory<int> async("AsyncSharedMemoryTest", sizeof(int), options);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        async.write(i);
+    }
+    async.flush();
+
+    EXPECT_EQ(async.published(), 1000U);
+    EXPECT_EQ(async.coalesced(), 0U);
+    EXPECT_EQ(async.channel().read(), 999);
+}
+
+// KeepLatest never blocks; dropped frames still complete and the newest frame wins
+TEST_F(AsyncSharedMemoryTest, KeepLatestCoalescesFrames)
+{
+    AsyncSharedMemoryOptions options;
+    options.queue_capacity = 1U;
+    options.coalescing = CoalescingPolicy::KeepLatest;
+    AsyncSharedMemory<int> async("AsyncSharedMemoryTest", sizeof(int), options);
+
+    const auto first = async.write(0);
+    for (int i = 1; i < 1000; ++i)
+    {
+        async.write(i);
+    }
+    async.flush();
+
+    EXPECT_TRUE(first.done());
+    EXPECT_EQ(async.published() + async.coalesced(), 1000U);
+    EXPECT_EQ(async.channel().read(), 999);
+}
+
+// A frame moved in is published like a copied one
+TEST_F(AsyncSharedMemoryTest, MoveWritePublishes)
+{
+    AsyncSharedMemory<float> async("AsyncSharedMemoryTest", sizeof(float));
+    float frame = 2.5F;
+    async.write(std::move(frame)).wait();
+
+    EXPECT_EQ(async.channel().read(), 2.5F);
+}
+
+// Destroying the channel publishes the frames still queued
+TEST_F(AsyncSharedMemoryTest, DestructorDrainsQueue)
+{
+    AsyncSharedMemoryOptions options;
+    options.queue_capacity = 16U;
+    {
+        AsyncSharedMemory<int> async("AsyncSharedMemoryTest", sizeof(int), options);
+        for (int i = 0; i < 16; ++i)
+        {
+            async.write(i);
+        }
+    }
+    SUCCEED();
+}
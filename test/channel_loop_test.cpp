@@ -0,0 +1,144 @@
+/// @file
+/// @brief Unit tests for the ChannelLoop class and SharedMemory::next().
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "channel_loop.h"
+#include "shared_memory.h"
+
+namespace
+{
+/// Minimal fire-and-forget coroutine type used to drive the awaitables.
+struct Detached
+{
+    struct promise_type
+    {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/// Read a number of values from a channel and append them to a vector.
+Detached readValues(SharedMemory<int> &channel, ChannelLoop &loop, int count, std::vector<int> &values)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        values.push_back(co_await channel.next(loop));
+    }
+}
+} // namespace
+
+// Test fixture for ChannelLoop
+class ChannelLoopTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory objects used in the tests.
+    ///
+    void TearDown() override
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            boost::interprocess::shared_memory_object::remove(("ChannelLoopTest" + std::to_string(i)).c_str());
+        }
+    }
+};
+
+// A value written before co_await completes without suspending
+TEST_F(ChannelLoopTest, NextCompletesImmediately)
+{
+    SharedMemory<int> channel("ChannelLoopTest0", sizeof(int));
+    ChannelLoop loop;
+    std::vector<int> values;
+
+    channel.write(7);
+    readValues(channel, loop, 1, values);
+
+    EXPECT_EQ(loop.pending(), 0U);
+    EXPECT_EQ(values, std::vector<int>{7});
+}
+
+// A suspended coroutine is resumed once the writer publishes
+TEST_F(ChannelLoopTest, NextSuspendsUntilWrite)
+{
+    SharedMemory<int> channel("ChannelLoopTest0", sizeof(int));
+    ChannelLoop loop;
+    std::vector<int> values;
+
+    readValues(channel, loop, 1, values);
+    EXPECT_EQ(loop.pending(), 1U);
+    EXPECT_EQ(loop.run_once(std::chrono::milliseconds(10)), 0U);
+
+    channel.write(11);
+    EXPECT_EQ(loop.run_once(std::chrono::seconds(1)), 1U);
+    EXPECT_EQ(loop.pending(), 0U);
+    EXPECT_EQ(values, std::vector<int>{11});
+}
+
+// One thread serves several channels written from other threads, with both notification mechanisms
+TEST_F(ChannelLoopTest, OneThreadServesManyChannels)
+{
+    constexpr int kValues = 50;
+    SharedMemoryOptions futex;
+    futex.notification = Notification::Futex;
+    std::vector<std::unique_ptr<SharedMemory<int>>> channels;
+    for (int i = 0; i < 4; ++i)
+    {
+        channels.push_back(std::make_unique<SharedMemory<int>>("ChannelLoopTest" + std::to_string(i), sizeof(int),
+                                                               i % 2 == 0 ? SharedMemoryOptions{} : futex));
+    }
+
+    ChannelLoop loop;
+    std::vector<std::vector<int>> values(channels.size());
+    for (std::size_t i = 0; i < channels.size(); ++i)
+    {
+        readValues(*channels[i], loop, kValues, values[i]);
+    }
+
+    std::vector<std::thread> writers;
+    for (std::size_t i = 0; i < channels.size(); ++i)
+    {
+        writers.emplace_back([&channels, &values, i]()
+                             {
+                                 for (int v = 0; v < kValues; ++v)
+                                 {
+                                     channels[i]->write(v);
+                                     // Wait for the value to be consumed so that none is overwritten.
+                                     while (values[i].size() <= static_cast<std::size_t>(v))
+                                     {
+                                         std::this_thread::yield();
+                                     }
+                                 } });
+    }
+    loop.run();
+    for (auto &writer : writers)
+    {
+        writer.join();
+    }
+
+    for (const auto &received : values)
+    {
+        ASSERT_EQ(received.size(), static_cast<std::size_t>(kValues));
+        EXPECT_EQ(received.back(), kValues - 1);
+    }
+}
+
+// next() throws if shared_data_ is nullptr
+TEST_F(ChannelLoopTest, NextThrowsOnNullSharedData)
+{
+    SharedMemory<int> channel("ChannelLoopTest0", sizeof(int));
+    ChannelLoop loop;
+    channel.setSharedDataNullptr();
+    EXPECT_THROW(channel.next(loop), std::runtime_error);
+}
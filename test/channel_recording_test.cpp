@@ -0,0 +1,139 @@
+/// @file
+/// @brief Unit tests for the ChannelRecorder and ChannelReplayer classes.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "channel_recording.h"
+#include "image.h"
+
+// Test fixture for channel recordings
+class ChannelRecordingTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory objects and the recording used in the tests.
+    ///
+    void TearDown() override
+    {
+        boost::interprocess::shared_memory_object::remove("ChannelRecordingTest");
+        boost::interprocess::shared_memory_object::remove("ChannelRecordingTestReplay");
+        std::filesystem::remove(path_);
+    }
+
+    const std::filesystem::path path_ = std::filesystem::temp_directory_path() / "ChannelRecordingTest.rec"; ///< Recording file.
+};
+
+// Recorded frames are indexed and decoded back
+TEST_F(ChannelRecordingTest, RecordAndDecode)
+{
+    {
+        ChannelRecorder<std::vector<float>> recorder(path_, 8U, 1024U);
+        EXPECT_EQ(recorder.record({1.0F, 2.0F}, 1U), ChannelRecorder<std::vector<float>>::RecordStatus::Success);
+        EXPECT_EQ(recorder.record({3.0F}, 5U), ChannelRecorder<std::vector<float>>::RecordStatus::Success);
+        EXPECT_EQ(recorder.size(), 2U);
+    }
+
+    const ChannelReplayer<std::vector<float>> replayer(path_);
+    ASSERT_EQ(replayer.size(), 2U);
+    EXPECT_EQ(replayer.entry(1U).sequence, 5U);
+    EXPECT_LE(replayer.entry(0U).timestamp_ns, replayer.entry(1U).timestamp_ns);
+    std::vector<float> frame;
+    replayer.frame(0U, frame);
+    EXPECT_EQ(frame, (std::vector<float>{1.0F, 2.0F}));
+    replayer.frame(1U, frame);
+    EXPECT_EQ(frame, std::vector<float>{3.0F});
+}
+
+// The recorder reports a full file instead of overflowing it
+TEST_F(ChannelRecordingTest, RecorderFull)
+{
+    ChannelRecorder<int> recorder(path_, 2U, 1024U);
+    EXPECT_EQ(recorder.record(1, 1U), ChannelRecorder<int>::RecordStatus::Success);
+    EXPECT_EQ(recorder.record(2, 2U), ChannelRecorder<int>::RecordStatus::Success);
+    EXPECT_EQ(recorder.record(3, 3U), ChannelRecorder<int>::RecordStatus::Full);
+}
+
+// A recording of one type is rejected by a replayer of another
+TEST_F(ChannelRecordingTest, ReplayerChecksFrameType)
+{
+    {
+        ChannelRecorder<int> recorder(path_, 1U, 64U);
+        recorder.record(1, 1U);
+    }
+    EXPECT_TRUE(ChannelReplayer<int>::matches(path_));
+    EXPECT_FALSE(ChannelReplayer<float>::matches(path_));
+    EXPECT_THROW(ChannelReplayer<float>{path_}, std::runtime_error);
+}
+
+// Frames published on a channel are recorded next to its reader and replayed onto another channel
+TEST_F(ChannelRecordingTest, RecordChannelAndReplay)
+{
+    const float value = 2.5F;
+    {
+        SharedMemory<float> channel("ChannelRecordingTest", 1U);
+        ChannelRecorder<float> recorder(path_, 16U, 4096U);
+        std::thread recording([&recorder, &channel]()
+                              { recorder.record_from(channel, std::chrono::steady_clock::now() + std::chrono::milliseconds(300)); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        channel.write(value);
+        // The recorder does not consume the data.
+        EXPECT_EQ(channel.read(), value);
+        recording.join();
+        EXPECT_EQ(recorder.size(), 1U);
+    }
+
+    const ChannelReplayer<float> replayer(path_);
+    SharedMemory<float> replay("ChannelRecordingTestReplay", 1U);
+    EXPECT_EQ(replayer.replay(replay, 0.0), 1U);
+    EXPECT_EQ(replay.read(), value);
+}
+
+// A flat channel is recorded from its next write and replayed onto an attached flat channel
+TEST_F(ChannelRecordingTest, RecordFlatChannelAndReplay)
+{
+    const Image<std::size_t> stale(std::vector<std::size_t>{9U}, 1U, 1U);
+    const Image<std::size_t> image(std::vector<std::size_t>{1U, 2U, 3U, 4U, 5U, 6U}, 3U, 2U);
+    {
+        SharedFlatMemory<Image<std::size_t>> channel("ChannelRecordingTest", 4096U);
+        channel.write(stale);
+        ChannelRecorder<Image<std::size_t>> recorder(path_, 16U, 4096U);
+        std::thread recording([&recorder, &channel]()
+                              { recorder.record_from(channel, std::chrono::steady_clock::now() + std::chrono::milliseconds(300)); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        channel.write(image);
+        recording.join();
+        // The value already on the channel before recording started is skipped.
+        EXPECT_EQ(recorder.size(), 1U);
+    }
+
+    const ChannelReplayer<Image<std::size_t>> replayer(path_);
+    EXPECT_EQ(replayer.entry(0U).sequence, 2U);
+    SharedFlatMemory<Image<std::size_t>> consumer("ChannelRecordingTestReplay", 4096U);
+    SegmentOptions options;
+    options.open_mode = OpenMode::Attach;
+    SharedFlatMemory<Image<std::size_t>> replay("ChannelRecordingTestReplay", 4096U, options);
+    EXPECT_EQ(replayer.replay(replay, 0.0), 1U);
+    EXPECT_EQ(consumer.read(), image);
+}
+
+// observe_until() reports every write with its sequence number and times out otherwise
+TEST_F(ChannelRecordingTest, ObserveDoesNotConsume)
+{
+    SharedMemory<int> channel("ChannelRecordingTest", sizeof(int));
+    std::uint64_t sequence = 0U;
+    int value = 0;
+    EXPECT_FALSE(channel.observe_until(value, sequence, std::chrono::steady_clock::now() + std::chrono::milliseconds(10)));
+
+    channel.write(4);
+    ASSERT_TRUE(channel.observe_until(value, sequence, std::chrono::steady_clock::now()));
+    EXPECT_EQ(value, 4);
+    EXPECT_EQ(sequence, 1U);
+    EXPECT_FALSE(channel.observe_until(value, sequence, std::chrono::steady_clock::now()));
+    EXPECT_EQ(channel.try_read(), 4);
+}
@@ -0,0 +1,105 @@
+/// @file
+/// @brief Unit tests for the payload copy kernels.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "copy_kernel.h"
+#include "image.h"
+#include "shared_flat_memory.h"
+#include "shared_image.h"
+
+// Test fixture for the copy kernels
+class CopyKernelTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory object used in the tests.
+    ///
+    void TearDown() override
+    {
+        boost::interprocess::shared_memory_object::remove("CopyKernelTest");
+    }
+
+    /// @brief Build a buffer of distinct bytes.
+    static std::vector<unsigned char> pattern(std::size_t size)
+    {
+        std::vector<unsigned char> bytes(size);
+        for (std::size_t i = 0U; i < size; ++i)
+        {
+            bytes[i] = static_cast<unsigned char>(i * 31U + 7U);
+        }
+        return bytes;
+    }
+};
+
+// Every kernel copies sizes around the vector width and unaligned destinations exactly
+TEST_F(CopyKernelTest, KernelsCopyUnalignedSizesExactly)
+{
+    const auto source = pattern(4096U + 64U);
+    for (const auto kernel : {CopyKernel::Memcpy, CopyKernel::StreamingAvx2})
+    {
+        for (const std::size_t offset : {0U, 1U, 31U})
+        {
+            for (const std::size_t size : {0U, 1U, 31U, 32U, 127U, 128U, 129U, 4096U})
+            {
+                std::vector<unsigned char> destination(source.size() + 64U, 0U);
+                copyBytes(destination.data() + offset, source.data(), size, kernel);
+                EXPECT_TRUE(std::equal(source.begin(), source.begin() + static_cast<std::ptrdiff_t>(size),
+                                       destination.begin() + static_cast<std::ptrdiff_t>(offset)));
+                // Bytes past the end are left untouched.
+                EXPECT_EQ(destination[offset + size], 0U);
+            }
+        }
+    }
+}
+
+// Large copies above the threshold go through the detected kernel
+TEST_F(CopyKernelTest, LargeCopyAboveThreshold)
+{
+    const auto source = pattern(kStreamingCopyThreshold + 3U);
+    std::vector<unsigned char> destination(source.size());
+    copyBytes(destination.data(), source.data(), source.size());
+    EXPECT_EQ(destination, source);
+}
+
+// copyPayload copies small and large trivially copyable payloads
+TEST_F(CopyKernelTest, CopyPayloadBySize)
+{
+    const std::array<std::uint16_t, 5> array{1U, 2U, 3U, 4U, 5U};
+    std::array<std::uint16_t, 5> array_copy{};
+    copyPayload(array, array_copy);
+    EXPECT_EQ(array_copy, array);
+
+    using Large = std::array<unsigned char, kStreamingCopyThreshold + 3U>;
+    const auto source = pattern(sizeof(Large));
+    auto large = std::make_unique<Large>();
+    auto large_copy = std::make_unique<Large>();
+    std::copy(source.begin(), source.end(), large->begin());
+    copyPayload(*large, *large_copy);
+    EXPECT_TRUE(std::equal(large_copy->begin(), large_copy->end(), source.begin()));
+}
+
+// Large frames written through the channels read back unchanged
+TEST_F(CopyKernelTest, ChannelsRoundTripLargeFrames)
+{
+    const std::size_t pixels = kStreamingCopyThreshold / sizeof(float) + 5U;
+    {
+        SharedFlatMemory<std::vector<float>> shared_memory("CopyKernelTest", pixels * sizeof(float));
+        const std::vector<float> frame(pixels, 1.5F);
+        ASSERT_EQ(shared_memory.write(frame), SharedFlatMemory<std::vector<float>>::WriteStatus::Success);
+        EXPECT_EQ(shared_memory.read(), frame);
+    }
+    {
+        SharedImage<std::uint8_t> shared_image("CopyKernelTest", pixels);
+        const Image<std::uint8_t> image(std::vector<std::uint8_t>(pixels, 9U), pixels, 1U);
+        ASSERT_EQ(shared_image.write(image), SharedImage<std::uint8_t>::WriteStatus::Success);
+        EXPECT_EQ(shared_image.read(), image);
+    }
+}
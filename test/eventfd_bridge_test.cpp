@@ -0,0 +1,99 @@
+/// @file
+/// @brief Unit tests for the EventFdPublisher and EventFdSubscriber classes.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <poll.h>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "eventfd_bridge.h"
+#include "shared_memory.h"
+
+namespace
+{
+/// Tell whether a file descriptor becomes readable within a timeout.
+bool readable(int fd, int timeout_ms)
+{
+    pollfd entry{fd, POLLIN, 0};
+    return poll(&entry, 1, timeout_ms) == 1 && (entry.revents & POLLIN) != 0;
+}
+} // namespace
+
+// Test fixture for the eventfd bridge
+class EventFdBridgeTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory object used in the tests.
+    ///
+    void TearDown() override
+    {
+        boost::interprocess::shared_memory_object::remove("EventFdBridgeTest");
+    }
+
+    /// @brief Options of a writer publishing the eventfd bridge.
+    static SharedMemoryOptions bridgeOptions()
+    {
+        SharedMemoryOptions options;
+        options.eventfd_bridge = true;
+        return options;
+    }
+};
+
+// The eventfd becomes readable after a write and is reset by consume()
+TEST_F(EventFdBridgeTest, WriteSignalsEventFd)
+{
+    SharedMemory<int> writer("EventFdBridgeTest", sizeof(int), bridgeOptions());
+    EventFdSubscriber subscriber("EventFdBridgeTest");
+    EXPECT_FALSE(readable(subscriber.fd(), 0));
+
+    EXPECT_EQ(writer.write(5), SharedMemory<int>::WriteStatus::Success);
+    EXPECT_TRUE(readable(subscriber.fd(), 1000));
+    EXPECT_EQ(subscriber.consume(), 1U);
+    EXPECT_FALSE(readable(subscriber.fd(), 0));
+    EXPECT_EQ(writer.try_read(), 5);
+}
+
+// Committed write loans and moved writes signal as well, and signals accumulate
+TEST_F(EventFdBridgeTest, EveryWritePathSignals)
+{
+    SharedMemory<int> writer("EventFdBridgeTest", sizeof(int), bridgeOptions());
+    EventFdSubscriber subscriber("EventFdBridgeTest");
+
+    auto loan = writer.acquire_write_slot();
+    *loan = 1;
+    loan.commit();
+    writer.write(2);
+
+    EXPECT_EQ(subscriber.consume(), 2U);
+    EXPECT_EQ(subscriber.consume(), 0U);
+}
+
+// Every subscriber is signalled, and closed subscribers are dropped
+TEST_F(EventFdBridgeTest, ManySubscribers)
+{
+    SharedMemory<int> writer("EventFdBridgeTest", sizeof(int), bridgeOptions());
+    EventFdSubscriber first("EventFdBridgeTest");
+    auto second = std::make_unique<EventFdSubscriber>("EventFdBridgeTest");
+
+    writer.write(1);
+    EXPECT_EQ(first.consume(), 1U);
+    EXPECT_EQ(second->consume(), 1U);
+
+    second.reset();
+    writer.write(2);
+    EXPECT_EQ(first.consume(), 1U);
+}
+
+// Subscribing requires a publisher, and only one instance can publish a channel
+TEST_F(EventFdBridgeTest, PublisherRequired)
+{
+    EXPECT_THROW(EventFdSubscriber("EventFdBridgeTest"), std::runtime_error);
+
+    EventFdPublisher publisher("EventFdBridgeTest");
+    EXPECT_THROW(EventFdPublisher("EventFdBridgeTest"), std::runtime_error);
+    EventFdSubscriber subscriber("EventFdBridgeTest");
+    publisher.notify();
+    EXPECT_EQ(publisher.subscribers(), 1U);
+}
@@ -0,0 +1,46 @@
+/// @file
+/// @brief Unit tests for the FutexEvent class.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "futex_event.h"
+
+// Notifying without waiters only bumps the word
+TEST(FutexEventTest, NotifyWithoutWaiters)
+{
+    FutexEvent event;
+    const auto before = event.value();
+    event.notify_all();
+    EXPECT_EQ(event.value(), before + 1U);
+}
+
+// Waiting on a stale value returns immediately
+TEST(FutexEventTest, WaitOnStaleValueReturns)
+{
+    FutexEvent event;
+    const auto seen = event.value();
+    event.notify_all();
+    event.wait(seen, 0U);
+    SUCCEED();
+}
+
+// A parked waiter is woken by notify_all
+TEST(FutexEventTest, NotifyWakesParkedWaiter)
+{
+    FutexEvent event;
+    std::atomic<bool> woken{false};
+
+    std::thread waiter_thread([&event, &woken]()
+                              {
+        event.wait(event.value(), 0U);
+        woken = true; });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(woken);
+    event.notify_all();
+    waiter_thread.join();
+    EXPECT_TRUE(woken);
+}
@@ -103,6 +103,40 @@ TEST_P(ImageParameterizedTest, EqualityOperator)
     EXPECT_FALSE(image1 == image3);
 }
 
+// Test reshape keeps the pixel buffer when the image does not grow
+TEST_P(ImageParameterizedTest, ReshapeReusesPixelBuffer)
+{
+    auto [width, height, num_channels] = GetParam();
+    Image<int> image(width, height, num_channels);
+    const auto *pixels = image.readData().data();
+
+    image.reshape(width / 2U, height, num_channels);
+    EXPECT_EQ(image.width(), width / 2U);
+    EXPECT_EQ(image.readData().size(), width / 2U * height * num_channels);
+    EXPECT_EQ(image.readData().data(), pixels);
+
+    image.data()[0] = 7;
+    EXPECT_EQ(image.pixelValue(0, 0, 0), 7);
+}
+
+// Test ImageView over existing pixel data
+TEST_P(ImageParameterizedTest, ImageViewMatchesImage)
+{
+    auto [width, height, num_channels] = GetParam();
+    std::vector<int> data(width * height * num_channels, 255);
+    const Image<int> image(data, width, height, num_channels);
+
+    ImageView<int> view(std::span<int>(data), width, height, num_channels);
+    EXPECT_EQ(view.width(), image.width());
+    EXPECT_EQ(view.height(), image.height());
+    EXPECT_EQ(view.num_channels(), image.num_channels());
+    EXPECT_EQ(view.size(), image.size());
+    EXPECT_EQ(view.readData().size(), image.readData().size());
+
+    view.pixelValue(width - 1U, height - 1U, num_channels - 1U) = 128;
+    EXPECT_EQ(data.back(), 128);
+}
+
 // Instantiate the parameterized tests with different sets of parameters
 INSTANTIATE_TEST_SUITE_P(
     ImageTests,
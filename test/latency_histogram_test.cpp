@@ -0,0 +1,102 @@
+/// @file
+/// @brief Unit tests for the LatencyHistogram class and the SharedMemory stats block.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "latency_histogram.h"
+#include "shared_memory.h"
+
+// Test fixture for LatencyHistogram
+class LatencyHistogramTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory object used in the tests.
+    ///
+    void TearDown() override
+    {
+        boost::interprocess::shared_memory_object::remove("LatencyHistogramTest");
+    }
+};
+
+// An empty histogram reports zeros
+TEST_F(LatencyHistogramTest, EmptyHistogram)
+{
+    const LatencyHistogram histogram;
+    const auto stats = histogram.stats();
+    EXPECT_EQ(stats.count, 0U);
+    EXPECT_EQ(stats.p50, 0U);
+    EXPECT_EQ(stats.max, 0U);
+}
+
+// Percentiles are within the 12.5 % bucket resolution
+TEST_F(LatencyHistogramTest, PercentilesWithinResolution)
+{
+    LatencyHistogram histogram;
+    for (std::uint64_t i = 1U; i <= 10000U; ++i)
+    {
+        histogram.record(i * 100U);
+    }
+
+    const auto stats = histogram.stats();
+    EXPECT_EQ(stats.count, 10000U);
+    EXPECT_EQ(stats.max, 1000000U);
+    EXPECT_NEAR(static_cast<double>(stats.p50), 500000.0, 500000.0 * 0.125);
+    EXPECT_NEAR(static_cast<double>(stats.p99), 990000.0, 990000.0 * 0.125);
+    EXPECT_GE(stats.p999, stats.p99);
+    EXPECT_LE(stats.p999, stats.max);
+}
+
+// Small and huge durations land in valid buckets
+TEST_F(LatencyHistogramTest, ExtremeValues)
+{
+    LatencyHistogram histogram;
+    histogram.record(0U);
+    histogram.record(UINT64_MAX);
+    EXPECT_EQ(histogram.percentile(0.0), 0U);
+    EXPECT_EQ(histogram.percentile(1.0), UINT64_MAX);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0U);
+}
+
+// A channel created with latency_stats times every write and read
+TEST_F(LatencyHistogramTest, ChannelStatsBlock)
+{
+    SharedMemoryOptions options;
+    options.latency_stats = true;
+    SharedMemory<int> writer("LatencyHistogramTest", sizeof(int), options);
+    SharedMemoryOptions attach;
+    attach.segment.open_mode = OpenMode::Attach;
+    SharedMemory<int> reader("LatencyHistogramTest", sizeof(int), attach);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        writer.write(i);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        EXPECT_EQ(reader.read(), i);
+    }
+
+    // Both instances see the same stats block.
+    const auto latency = writer.latency();
+    EXPECT_EQ(latency.count, 10U);
+    EXPECT_GE(latency.p50, 1000000U * 7U / 8U);
+    EXPECT_EQ(reader.inter_arrival().count, 9U);
+
+    reader.reset_stats();
+    EXPECT_EQ(writer.latency().count, 0U);
+}
+
+// Without latency_stats nothing is recorded
+TEST_F(LatencyHistogramTest, StatsDisabledByDefault)
+{
+    SharedMemory<int> channel("LatencyHistogramTest", sizeof(int));
+    channel.write(1);
+    channel.read();
+    EXPECT_EQ(channel.latency().count, 0U);
+    EXPECT_EQ(channel.inter_arrival().count, 0U);
+}
@@ -0,0 +1,152 @@
+/// @file
+/// @brief Unit tests for the SharedBroadcast class.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "shared_broadcast.h"
+
+// Test fixture for SharedBroadcast
+class SharedBroadcastTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory object used in the tests.
+    ///
+    void TearDown() override
+    {
+        boost::interprocess::shared_memory_object::remove("SharedBroadcastTest");
+    }
+};
+
+// Every subscriber sees every frame
+TEST_F(SharedBroadcastTest, EverySubscriberSeesEveryFrame)
+{
+    SharedBroadcast<int> broadcast("SharedBroadcastTest", 8U, 4U);
+    auto first = broadcast.subscribe();
+    auto second = broadcast.subscribe();
+    EXPECT_EQ(broadcast.subscribers(), 2U);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(broadcast.write(i), SharedBroadcast<int>::WriteStatus::Success);
+    }
+
+    EXPECT_EQ(first.pending(), 5U);
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(first.read(), i);
+    }
+    EXPECT_FALSE(first.try_read().has_value());
+
+    EXPECT_EQ(second.pending(), 5U);
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(second.read(), i);
+    }
+}
+
+// A subscriber starts at the next frame published after it registered
+TEST_F(SharedBroadcastTest, LateSubscriberStartsAtNextFrame)
+{
+    SharedBroadcast<float> broadcast("SharedBroadcastTest", 4U, 2U);
+    broadcast.write(1.0F);
+
+    auto subscriber = broadcast.subscribe();
+    EXPECT_FALSE(subscriber.try_read().has_value());
+    broadcast.write(2.0F);
+    EXPECT_EQ(subscriber.read(), 2.0F);
+}
+
+// The cursor of a subscriber process that exited without unregistering stops holding back the writer
+TEST_F(SharedBroadcastTest, DeadSubscriberIsDropped)
+{
+    SharedBroadcast<int> broadcast("SharedBroadcastTest", 2U, 2U);
+    const pid_t child = fork();
+    if (child == 0)
+    {
+        SegmentOptions options;
+        options.open_mode = OpenMode::Attach;
+        SharedBroadcast<int> attached("SharedBroadcastTest", 2U, 2U, options);
+        // Leak the cursor, as a crashing subscriber would.
+        new SharedBroadcast<int>::Subscriber(attached.subscribe());
+        _exit(0);
+    }
+    ASSERT_GT(child, 0);
+    waitpid(child, nullptr, 0);
+    EXPECT_EQ(broadcast.subscribers(), 1U);
+
+    EXPECT_EQ(broadcast.write(1), SharedBroadcast<int>::WriteStatus::Success);
+    EXPECT_EQ(broadcast.write(2), SharedBroadcast<int>::WriteStatus::Success);
+    EXPECT_EQ(broadcast.write(3), SharedBroadcast<int>::WriteStatus::Success);
+    EXPECT_EQ(broadcast.subscribers(), 0U);
+}
+
+// The slowest subscriber holds back the writer, and leaving releases it
+TEST_F(SharedBroadcastTest, SlowestSubscriberAppliesBackPressure)
+{
+    SharedBroadcast<float> broadcast("SharedBroadcastTest", 2U, 2U);
+    auto fast = broadcast.subscribe();
+    {
+        auto slow = broadcast.subscribe();
+        EXPECT_EQ(broadcast.write(1.0F), SharedBroadcast<float>::WriteStatus::Success);
+        EXPECT_EQ(broadcast.write(2.0F), SharedBroadcast<float>::WriteStatus::Success);
+        EXPECT_EQ(fast.read(), 1.0F);
+        EXPECT_EQ(fast.read(), 2.0F);
+        EXPECT_EQ(broadcast.write(3.0F), SharedBroadcast<float>::WriteStatus::Full);
+    }
+    EXPECT_EQ(broadcast.subscribers(), 1U);
+    EXPECT_EQ(broadcast.write(3.0F), SharedBroadcast<float>::WriteStatus::Success);
+    EXPECT_EQ(fast.read(), 3.0F);
+}
+
+// Subscribing fails once every cursor is in use
+TEST_F(SharedBroadcastTest, SubscribeFailsWhenCursorsAreExhausted)
+{
+    SharedBroadcast<int> broadcast("SharedBroadcastTest", 2U, 1U);
+    auto subscriber = broadcast.subscribe();
+    EXPECT_THROW(broadcast.subscribe(), std::runtime_error);
+}
+
+// Concurrent subscribers each receive the whole stream
+TEST_F(SharedBroadcastTest, ConcurrentSubscribers)
+{
+    constexpr int kFrames = 5000;
+    SharedBroadcast<int> broadcast("SharedBroadcastTest", 16U, 3U);
+    std::vector<SharedBroadcast<int>::Subscriber> subscribers;
+    for (int i = 0; i < 3; ++i)
+    {
+        subscribers.push_back(broadcast.subscribe());
+    }
+
+    std::vector<std::thread> reader_threads;
+    for (auto &subscriber : subscribers)
+    {
+        reader_threads.emplace_back([&subscriber]()
+                                    {
+            for (int i = 0; i < kFrames; ++i)
+            {
+                EXPECT_EQ(subscriber.read(), i);
+            } });
+    }
+
+    std::thread writer_thread([&broadcast]()
+                              {
+        for (int i = 0; i < kFrames; ++i)
+        {
+            while (broadcast.write(i) == SharedBroadcast<int>::WriteStatus::Full)
+            {
+                std::this_thread::yield();
+            }
+        } });
+
+    writer_thread.join();
+    for (auto &reader_thread : reader_threads)
+    {
+        reader_thread.join();
+    }
+}
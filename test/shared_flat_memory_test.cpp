@@ -0,0 +1,203 @@
+/// @file
+/// @brief Unit tests for the shm_traits layouts and the SharedFlatMemory class.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "image.h"
+#include "shared_flat_memory.h"
+#include "shm_traits.h"
+
+namespace
+{
+/// A user type without heap memory, laid out by the trivially copyable specialization.
+struct Pose
+{
+    double x;
+    double y;
+    float heading;
+};
+
+static_assert(ShmSerializable<int>);
+static_assert(ShmSerializable<Pose>);
+static_assert(ShmSerializable<std::array<float, 4>>);
+static_assert(ShmSerializable<std::vector<float>>);
+static_assert(ShmSerializable<Image<std::uint8_t>>);
+
+/// Serialize a value into an aligned buffer.
+template <typename T>
+std::vector<std::uint64_t> flatten(const T &value, std::size_t &size)
+{
+    size = shm_traits<T>::flat_size(value);
+    std::vector<std::uint64_t> buffer((size + sizeof(std::uint64_t) - 1U) / sizeof(std::uint64_t) + 1U);
+    shm_traits<T>::serialize(value, std::span<unsigned char>(static_cast<unsigned char *>(static_cast<void *>(buffer.data())), size));
+    return buffer;
+}
+
+/// View the serialized bytes of a buffer.
+std::span<const unsigned char> bytes(const std::vector<std::uint64_t> &buffer, std::size_t size)
+{
+    return std::span<const unsigned char>(static_cast<const unsigned char *>(static_cast<const void *>(buffer.data())), size);
+}
+} // namespace
+
+// Test fixture for SharedFlatMemory
+class SharedFlatMemoryTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory object used in the tests.
+    ///
+    void TearDown() override
+    {
+        boost::interprocess::shared_memory_object::remove("SharedFlatMemoryTest");
+    }
+};
+
+// A trivially copyable user type round-trips through its object representation
+TEST_F(SharedFlatMemoryTest, TriviallyCopyableLayout)
+{
+    const Pose pose{1.0, -2.0, 0.5F};
+    std::size_t size = 0U;
+    const auto buffer = flatten(pose, size);
+    EXPECT_EQ(size, sizeof(Pose));
+    EXPECT_EQ(shm_traits<Pose>::view(bytes(buffer, size)).y, -2.0);
+    Pose out{};
+    shm_traits<Pose>::deserialize(bytes(buffer, size), out);
+    EXPECT_EQ(out.heading, 0.5F);
+}
+
+// Vectors and arrays are laid out as their elements and viewed as spans
+TEST_F(SharedFlatMemoryTest, VectorAndArrayLayout)
+{
+    const std::vector<float> vector{1.0F, 2.0F, 3.0F};
+    std::size_t size = 0U;
+    const auto vector_buffer = flatten(vector, size);
+    EXPECT_EQ(size, 3U * sizeof(float));
+    const auto span = shm_traits<std::vector<float>>::view(bytes(vector_buffer, size));
+    EXPECT_EQ(std::vector<float>(span.begin(), span.end()), vector);
+
+    using Array = std::array<std::uint16_t, 3>;
+    const Array array{7U, 8U, 9U};
+    const auto array_buffer = flatten(array, size);
+    EXPECT_EQ(shm_traits<Array>::view(bytes(array_buffer, size))[2], 9U);
+    Array array_out{};
+    shm_traits<Array>::deserialize(bytes(array_buffer, size), array_out);
+    EXPECT_EQ(array_out, array);
+}
+
+// Images carry their shape before the pixels
+TEST_F(SharedFlatMemoryTest, ImageLayout)
+{
+    const Image<std::uint8_t> image(std::vector<std::uint8_t>{1U, 2U, 3U, 4U, 5U, 6U}, 3U, 1U, 2U);
+    std::size_t size = 0U;
+    const auto buffer = flatten(image, size);
+    const auto view = shm_traits<Image<std::uint8_t>>::view(bytes(buffer, size));
+    EXPECT_EQ(view.width(), 3U);
+    EXPECT_EQ(view.num_channels(), 2U);
+    EXPECT_EQ(view.pixelValue(1U, 0U, 1U), 5U);
+    Image<std::uint8_t> out;
+    shm_traits<Image<std::uint8_t>>::deserialize(bytes(buffer, size), out);
+    EXPECT_EQ(out, image);
+}
+
+// Truncated image layouts are rejected before the shape or the pixels are read
+TEST_F(SharedFlatMemoryTest, TruncatedImageLayoutThrows)
+{
+    const Image<std::uint8_t> image(std::vector<std::uint8_t>{1U, 2U, 3U, 4U, 5U, 6U}, 3U, 1U, 2U);
+    std::size_t size = 0U;
+    const auto buffer = flatten(image, size);
+    Image<std::uint8_t> out;
+    EXPECT_THROW(shm_traits<Image<std::uint8_t>>::view(bytes(buffer, 4U)), std::runtime_error);
+    EXPECT_THROW(shm_traits<Image<std::uint8_t>>::deserialize(bytes(buffer, size - 1U), out), std::runtime_error);
+    EXPECT_THROW(shm_traits<int>::view(bytes(buffer, 2U)), std::runtime_error);
+}
+
+// observe_until() reports every write with its sequence number without consuming it
+TEST_F(SharedFlatMemoryTest, ObserveDoesNotConsume)
+{
+    SharedFlatMemory<std::vector<float>> shared("SharedFlatMemoryTest", 1024U);
+    std::uint64_t sequence = shared.sequence();
+    std::vector<float> value;
+    EXPECT_FALSE(shared.observe_until(value, sequence, std::chrono::steady_clock::now() + std::chrono::milliseconds(10)));
+
+    shared.write(std::vector<float>{2.0F, 3.0F});
+    ASSERT_TRUE(shared.observe_until(value, sequence, std::chrono::steady_clock::now()));
+    EXPECT_EQ(value, (std::vector<float>{2.0F, 3.0F}));
+    EXPECT_EQ(sequence, 1U);
+    EXPECT_FALSE(shared.observe_until(value, sequence, std::chrono::steady_clock::now()));
+    EXPECT_EQ(shared.read(), (std::vector<float>{2.0F, 3.0F}));
+}
+
+// A vector written by one instance is read in full by another attached to the segment
+TEST_F(SharedFlatMemoryTest, VectorCrossesInstances)
+{
+    SharedFlatMemory<std::vector<float>> writer("SharedFlatMemoryTest", 1024U);
+    SegmentOptions options;
+    options.open_mode = OpenMode::Attach;
+    const SharedFlatMemory<std::vector<float>> reader("SharedFlatMemoryTest", 1024U, options);
+
+    const std::vector<float> data(100U, 4.5F);
+    ASSERT_EQ(writer.write(data), SharedFlatMemory<std::vector<float>>::WriteStatus::Success);
+    {
+        const auto loan = reader.acquire_read_slot();
+        EXPECT_EQ(loan.view().size(), 100U);
+        EXPECT_EQ(loan.view()[99], 4.5F);
+    }
+    ASSERT_EQ(writer.write(std::vector<float>{1.0F}), SharedFlatMemory<std::vector<float>>::WriteStatus::Success);
+    EXPECT_EQ(reader.read(), std::vector<float>{1.0F});
+}
+
+// read_into deserializes into the caller's buffers without reallocating them
+TEST_F(SharedFlatMemoryTest, ReadIntoReusesCallerBuffers)
+{
+    {
+        SharedFlatMemory<Image<std::size_t>> images("SharedFlatMemoryTest", 4096U);
+        Image<std::size_t> image;
+        images.write(Image<std::size_t>(std::vector<std::size_t>(12U, 3U), 4U, 3U));
+        images.read_into(image);
+        const auto *pixels = image.readData().data();
+        images.write(Image<std::size_t>(std::vector<std::size_t>(12U, 5U), 3U, 4U));
+        images.read_into(image);
+        EXPECT_EQ(image, Image<std::size_t>(std::vector<std::size_t>(12U, 5U), 3U, 4U));
+        EXPECT_EQ(image.readData().data(), pixels);
+    }
+
+    SharedFlatMemory<std::vector<float>> vectors("SharedFlatMemoryTest", 1024U);
+    std::vector<float> vector;
+    vectors.write(std::vector<float>(100U, 1.0F));
+    vectors.read_into(vector);
+    const auto *elements = vector.data();
+    const auto capacity = vector.capacity();
+    vectors.write(std::vector<float>(50U, 2.0F));
+    vectors.read_into(vector);
+    EXPECT_EQ(vector, std::vector<float>(50U, 2.0F));
+    EXPECT_EQ(vector.data(), elements);
+    EXPECT_EQ(vector.capacity(), capacity);
+}
+
+// Values larger than the buffer are rejected
+TEST_F(SharedFlatMemoryTest, WriteFailsWhenTooLarge)
+{
+    SharedFlatMemory<std::vector<float>> shared("SharedFlatMemoryTest", 4U * sizeof(float));
+    EXPECT_EQ(shared.write(std::vector<float>(5U, 1.0F)), SharedFlatMemory<std::vector<float>>::WriteStatus::Failure);
+    EXPECT_EQ(shared.capacity(), 4U * sizeof(float));
+}
+
+// Images round-trip between a writer and a reader thread
+TEST_F(SharedFlatMemoryTest, ImageRoundTrip)
+{
+    SharedFlatMemory<Image<std::size_t>> shared("SharedFlatMemoryTest", 4096U);
+    const Image<std::size_t> image(std::vector<std::size_t>(12U, 3U), 4U, 3U);
+    std::thread writer([&shared, &image]()
+                       { shared.write(image); });
+    EXPECT_EQ(shared.read(), image);
+    writer.join();
+}
@@ -0,0 +1,129 @@
+/// @file
+/// @brief Unit tests for the SharedFramePool class.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "shared_frame_pool.h"
+#include "shared_ring_buffer.h"
+
+// Test fixture for SharedFramePool
+class SharedFramePoolTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory objects used in the tests.
+    ///
+    void TearDown() override
+    {
+        boost::interprocess::shared_memory_object::remove("SharedFramePoolTest");
+        boost::interprocess::shared_memory_object::remove("SharedFramePoolTestStage1");
+        boost::interprocess::shared_memory_object::remove("SharedFramePoolTestStage2");
+    }
+};
+
+// Frames are handed out until the pool is exhausted and come back once released
+TEST_F(SharedFramePoolTest, AcquireUntilExhausted)
+{
+    SharedFramePool<std::uint8_t> pool("SharedFramePoolTest", 100U, 2U);
+    EXPECT_EQ(pool.free_frames(), 2U);
+    {
+        auto first = pool.try_acquire();
+        auto second = pool.try_acquire();
+        ASSERT_TRUE(first && second);
+        EXPECT_NE(first->index(), second->index());
+        EXPECT_EQ(first->data().size(), 100U);
+        EXPECT_FALSE(pool.try_acquire());
+        EXPECT_EQ(pool.free_frames(), 0U);
+    }
+    EXPECT_EQ(pool.free_frames(), 2U);
+}
+
+// A shared frame stays in use until every consumer released it
+TEST_F(SharedFramePoolTest, ShareAddsReferences)
+{
+    SharedFramePool<float> pool("SharedFramePoolTest", 16U, 1U);
+    auto frame = pool.try_acquire();
+    ASSERT_TRUE(frame);
+    const auto index = frame->index();
+    std::optional<SharedFramePool<float>::Frame> copy(frame->share());
+    EXPECT_EQ(pool.refcount(index), 2U);
+
+    frame.reset();
+    EXPECT_EQ(pool.refcount(index), 1U);
+    EXPECT_FALSE(pool.try_acquire());
+    copy.reset();
+    EXPECT_EQ(pool.refcount(index), 0U);
+}
+
+// Frames travel by index through a two-stage pipeline without being copied
+TEST_F(SharedFramePoolTest, PipelinePassesIndices)
+{
+    constexpr int kFrames = 200;
+    SharedFramePool<std::size_t> pool("SharedFramePoolTest", 1024U, 4U);
+    SharedRingBuffer<std::uint32_t> stage1("SharedFramePoolTestStage1", 4U);
+    SharedRingBuffer<std::uint32_t> stage2("SharedFramePoolTestStage2", 4U);
+
+    std::thread capture([&pool, &stage1]()
+                        {
+                            for (int i = 0; i < kFrames; ++i)
+                            {
+                                auto frame = pool.try_acquire();
+                                while (!frame)
+                                {
+                                    std::this_thread::yield();
+                                    frame = pool.try_acquire();
+                                }
+                                std::fill(frame->data().begin(), frame->data().end(), static_cast<std::size_t>(i));
+                                const auto index = frame->detach();
+                                while (stage1.write(index) != SharedRingBuffer<std::uint32_t>::WriteStatus::Success)
+                                {
+                                    std::this_thread::yield();
+                                }
+                            } });
+    std::thread denoise([&pool, &stage1, &stage2]()
+                        {
+                            for (int i = 0; i < kFrames; ++i)
+                            {
+                                auto frame = pool.adopt(stage1.read());
+                                for (auto &value : frame.data())
+                                {
+                                    value *= 2U;
+                                }
+                                const auto index = frame.detach();
+                                while (stage2.write(index) != SharedRingBuffer<std::uint32_t>::WriteStatus::Success)
+                                {
+                                    std::this_thread::yield();
+                                }
+                            } });
+
+    for (int i = 0; i < kFrames; ++i)
+    {
+        const auto frame = pool.adopt(stage2.read());
+        const auto data = frame.data();
+        EXPECT_EQ(data.front(), 2U * static_cast<std::size_t>(i));
+        EXPECT_EQ(data.back(), 2U * static_cast<std::size_t>(i));
+    }
+    capture.join();
+    denoise.join();
+    EXPECT_EQ(pool.free_frames(), 4U);
+}
+
+// A second instance attaches to the same frames
+TEST_F(SharedFramePoolTest, SecondInstanceSharesFrames)
+{
+    SharedFramePool<std::uint8_t> producer("SharedFramePoolTest", 64U, 2U);
+    SharedFramePool<std::uint8_t> consumer("SharedFramePoolTest", 64U, 2U);
+
+    auto frame = producer.try_acquire();
+    ASSERT_TRUE(frame);
+    frame->data()[0] = 42U;
+    const auto received = consumer.adopt(frame->detach());
+    EXPECT_EQ(received.data()[0], 42U);
+    EXPECT_EQ(consumer.refcount(received.index()), 1U);
+}
@@ -0,0 +1,152 @@
+/// @file
+/// @brief Unit tests for the SharedImage class.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "shared_image.h"
+
+// Test fixture for SharedImage
+class SharedImageTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory object used in the tests.
+    ///
+    void TearDown() override
+    {
+        boost::interprocess::shared_memory_object::remove("SharedImageTest");
+    }
+
+    /// @brief Build a test image whose pixels hold their own index.
+    ///
+    static Image<std::size_t> makeImage(std::size_t width, std::size_t height, std::size_t num_channels)
+    {
+        std::vector<std::size_t> data(width * height * num_channels);
+        for (std::size_t i = 0U; i < data.size(); ++i)
+        {
+            data[i] = i;
+        }
+        return Image<std::size_t>(data, width, height, num_channels);
+    }
+};
+
+// Write and read an image through the segment
+TEST_F(SharedImageTest, WriteAndReadImage)
+{
+    const auto image = makeImage(100U, 50U, 3U);
+    SharedImage<std::size_t> sharedImage("SharedImageTest", 100U * 100U * 3U);
+
+    EXPECT_EQ(sharedImage.write(image), SharedImage<std::size_t>::WriteStatus::Success);
+    const auto value = sharedImage.read();
+    EXPECT_EQ(value, image);
+    EXPECT_EQ(value.num_channels(), 3U);
+}
+
+// An image larger than the segment is rejected
+TEST_F(SharedImageTest, WriteFailsWhenImageDoesNotFit)
+{
+    SharedImage<std::size_t> sharedImage("SharedImageTest", 10U * 10U);
+    EXPECT_EQ(sharedImage.write(makeImage(11U, 10U, 1U)), SharedImage<std::size_t>::WriteStatus::Failure);
+    EXPECT_THROW(sharedImage.acquire_write_slot(10U, 10U, 2U), std::length_error);
+}
+
+// A reader sees the pixels the writer filled in place, without a copy
+TEST_F(SharedImageTest, LoanedPixelsLiveInTheSegment)
+{
+    SharedImage<std::uint8_t> sharedImage("SharedImageTest", 64U * 64U * 3U);
+    {
+        auto loan = sharedImage.acquire_write_slot(64U, 32U, 3U);
+        std::fill(loan->data().begin(), loan->data().end(), std::uint8_t{7U});
+        loan->pixelValue(5U, 6U, 2U) = 200U;
+        loan.commit();
+    }
+
+    const auto loan = sharedImage.acquire_read_slot();
+    EXPECT_EQ(loan->width(), 64U);
+    EXPECT_EQ(loan->height(), 32U);
+    EXPECT_EQ(loan->num_channels(), 3U);
+    EXPECT_EQ(loan->readData().size(), 64U * 32U * 3U);
+    EXPECT_EQ(loan->pixelValue(5U, 6U, 2U), 200U);
+    EXPECT_EQ(loan->pixelValue(0U, 0U, 0U), 7U);
+}
+
+// Concurrent access to the shared image
+TEST_F(SharedImageTest, ConcurrentAccess)
+{
+    const auto image = makeImage(100U, 100U, 1U);
+    SharedImage<std::size_t> sharedImage("SharedImageTest", image.size());
+
+    std::thread writer_thread([&sharedImage, &image]()
+                              {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        sharedImage.write(image); });
+
+    std::thread reader_thread([&sharedImage, &image]()
+                              { EXPECT_EQ(sharedImage.read(), image); });
+
+    writer_thread.join();
+    reader_thread.join();
+}
+
+// Only the dirty regions are copied, and a reader's copy is patched with them
+TEST_F(SharedImageTest, DirtyRegionWrites)
+{
+    auto image = makeImage(16U, 8U, 2U);
+    SharedImage<std::size_t> sharedImage("SharedImageTest", image.readData().size());
+    ASSERT_EQ(sharedImage.write(image), SharedImage<std::size_t>::WriteStatus::Success);
+
+    Image<std::size_t> copy;
+    EXPECT_EQ(sharedImage.read_delta(copy), (std::vector<ImageRegion>{{0U, 0U, 16U, 8U}}));
+    EXPECT_EQ(copy, image);
+
+    image.pixelValue(3U, 2U, 1U) = 1000U;
+    image.pixelValue(15U, 7U, 0U) = 2000U;
+    image.pixelValue(0U, 0U, 0U) = 3000U; // changed, but not reported dirty
+    const std::vector<ImageRegion> regions{{2U, 2U, 2U, 1U}, {15U, 7U, 1U, 1U}};
+    ASSERT_EQ(sharedImage.write_regions(image, regions), SharedImage<std::size_t>::WriteStatus::Success);
+
+    EXPECT_EQ(sharedImage.read_delta(copy), regions);
+    EXPECT_EQ(copy.pixelValue(3U, 2U, 1U), 1000U);
+    EXPECT_EQ(copy.pixelValue(15U, 7U, 0U), 2000U);
+    EXPECT_EQ(copy.pixelValue(0U, 0U, 0U), 0U);
+}
+
+// Dirty regions accumulate until a reader consumes the image, merging once the set is full
+TEST_F(SharedImageTest, DirtySetAccumulates)
+{
+    const auto image = makeImage(64U, 64U, 1U);
+    SharedImage<std::size_t> sharedImage("SharedImageTest", image.size());
+    sharedImage.write(image);
+    sharedImage.read();
+
+    for (std::size_t i = 0U; i < SharedImage<std::size_t>::kMaxDirtyRegions + 4U; ++i)
+    {
+        const ImageRegion region{i, i, 1U, 1U};
+        sharedImage.write_regions(image, std::span<const ImageRegion>(&region, 1U));
+    }
+
+    const auto loan = sharedImage.acquire_read_slot();
+    const auto dirty = loan.dirty();
+    ASSERT_EQ(dirty.size(), SharedImage<std::size_t>::kMaxDirtyRegions);
+    EXPECT_EQ(dirty.front(), (ImageRegion{0U, 0U, 1U, 1U}));
+    const auto last = SharedImage<std::size_t>::kMaxDirtyRegions - 1U;
+    EXPECT_EQ(dirty.back(), (ImageRegion{last, last, 5U, 5U}));
+}
+
+// Regions out of bounds or a shape change are rejected
+TEST_F(SharedImageTest, DirtyRegionWriteFailures)
+{
+    const auto image = makeImage(8U, 8U, 1U);
+    SharedImage<std::size_t> sharedImage("SharedImageTest", 256U);
+    const std::vector<ImageRegion> regions{{0U, 0U, 1U, 1U}};
+    EXPECT_EQ(sharedImage.write_regions(image, regions), SharedImage<std::size_t>::WriteStatus::Failure);
+
+    sharedImage.write(image);
+    const std::vector<ImageRegion> outside{{7U, 0U, 2U, 1U}};
+    EXPECT_EQ(sharedImage.write_regions(image, outside), SharedImage<std::size_t>::WriteStatus::Failure);
+    EXPECT_EQ(sharedImage.write_regions(makeImage(16U, 4U, 1U), regions), SharedImage<std::size_t>::WriteStatus::Failure);
+}
@@ -0,0 +1,130 @@
+/// @file
+/// @brief Unit tests for the SharedImageTripleBuffer class.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "shared_image_triple_buffer.h"
+
+// Test fixture for SharedImageTripleBuffer
+class SharedImageTripleBufferTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory object used in the tests.
+    ///
+    void TearDown() override
+    {
+        boost::interprocess::shared_memory_object::remove("SharedImageTripleBufferTest");
+    }
+
+    /// @brief Build a test image with every pixel set to the same value.
+    ///
+    static Image<std::size_t> makeImage(std::size_t width, std::size_t height, std::size_t value)
+    {
+        return Image<std::size_t>(std::vector<std::size_t>(width * height, value), width, height);
+    }
+};
+
+// Nothing is read before the first write
+TEST_F(SharedImageTripleBufferTest, ReadBeforeWriteIsEmpty)
+{
+    SharedImageTripleBuffer<std::size_t> buffer("SharedImageTripleBufferTest", 16U * 16U);
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.front().size(), 0U);
+    EXPECT_EQ(buffer.read().size(), 0U);
+}
+
+// The reader gets the newest image and skips the overwritten ones
+TEST_F(SharedImageTripleBufferTest, ReaderGetsNewestImage)
+{
+    SharedImageTripleBuffer<std::size_t> buffer("SharedImageTripleBufferTest", 16U * 16U);
+    for (std::size_t i = 1U; i <= 5U; ++i)
+    {
+        EXPECT_EQ(buffer.write(makeImage(16U, 8U, i)), SharedImageTripleBuffer<std::size_t>::WriteStatus::Success);
+    }
+
+    EXPECT_EQ(buffer.read(), makeImage(16U, 8U, 5U));
+
+    // The front buffer is kept until a new image is published.
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.front().pixelValue(0U, 0U, 0U), 5U);
+}
+
+// The front buffer is not touched by later writes
+TEST_F(SharedImageTripleBufferTest, FrontBufferIsStableWhileWriting)
+{
+    SharedImageTripleBuffer<std::uint8_t> buffer("SharedImageTripleBufferTest", 8U * 8U * 3U);
+    {
+        auto loan = buffer.acquire_write_slot(8U, 8U, 3U);
+        std::fill(loan->data().begin(), loan->data().end(), std::uint8_t{1U});
+        loan.commit();
+    }
+    EXPECT_TRUE(buffer.update());
+    const auto front = buffer.front();
+
+    for (std::uint8_t i = 2U; i < 10U; ++i)
+    {
+        auto loan = buffer.acquire_write_slot(8U, 8U, 3U);
+        std::fill(loan->data().begin(), loan->data().end(), i);
+        loan.commit();
+    }
+
+    EXPECT_EQ(front.num_channels(), 3U);
+    for (const auto value : front.readData())
+    {
+        EXPECT_EQ(value, 1U);
+    }
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.front().pixelValue(7U, 7U, 2U), 9U);
+}
+
+// An image larger than a buffer is rejected
+TEST_F(SharedImageTripleBufferTest, WriteFailsWhenImageDoesNotFit)
+{
+    SharedImageTripleBuffer<std::size_t> buffer("SharedImageTripleBufferTest", 10U * 10U);
+    EXPECT_EQ(buffer.write(makeImage(11U, 10U, 1U)), SharedImageTripleBuffer<std::size_t>::WriteStatus::Failure);
+    EXPECT_THROW(buffer.acquire_write_slot(10U, 11U), std::length_error);
+}
+
+// Concurrent writer and reader only ever see complete images in increasing order
+TEST_F(SharedImageTripleBufferTest, ConcurrentAccessSeesCompleteImages)
+{
+    SharedImageTripleBuffer<std::size_t> buffer("SharedImageTripleBufferTest", 32U * 32U);
+    std::atomic<bool> done{false};
+
+    std::thread writer_thread([&buffer, &done]()
+                              {
+        for (std::size_t i = 1U; i <= 2000U; ++i)
+        {
+            buffer.write(makeImage(32U, 32U, i));
+        }
+        done = true; });
+
+    std::thread reader_thread([&buffer, &done]()
+                              {
+        std::size_t last = 0U;
+        while (!done)
+        {
+            if (!buffer.update())
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            const auto data = buffer.front().readData();
+            ASSERT_EQ(data.size(), 32U * 32U);
+            EXPECT_GT(data.front(), last);
+            last = data.front();
+            for (const auto value : data)
+            {
+                EXPECT_EQ(value, last);
+            }
+        } });
+
+    writer_thread.join();
+    reader_thread.join();
+    EXPECT_EQ(buffer.read().pixelValue(0U, 0U, 0U), 2000U);
+}
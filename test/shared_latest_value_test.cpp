@@ -0,0 +1,82 @@
+/// @file
+/// @brief Unit tests for the SharedLatestValue class.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "shared_latest_value.h"
+
+// Test fixture for SharedLatestValue
+class SharedLatestValueTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory object used in the tests.
+    ///
+    void TearDown() override
+    {
+        boost::interprocess::shared_memory_object::remove("SharedLatestValueTest");
+    }
+};
+
+// Reading before any write returns a zero value at version 0
+TEST_F(SharedLatestValueTest, ReadBeforeWrite)
+{
+    SharedLatestValue<int> latest("SharedLatestValueTest");
+    EXPECT_EQ(latest.read(), 0);
+    EXPECT_EQ(latest.version(), 0U);
+}
+
+// Only the newest value is kept, and reads do not consume it
+TEST_F(SharedLatestValueTest, ReadReturnsNewestValue)
+{
+    SharedLatestValue<float> latest("SharedLatestValueTest");
+    EXPECT_EQ(latest.write(1.0F), SharedLatestValue<float>::WriteStatus::Success);
+    EXPECT_EQ(latest.write(2.0F), SharedLatestValue<float>::WriteStatus::Success);
+
+    EXPECT_EQ(latest.read(), 2.0F);
+    EXPECT_EQ(latest.read(), 2.0F);
+
+    const auto snapshot = latest.snapshot();
+    EXPECT_EQ(snapshot.value, 2.0F);
+    EXPECT_EQ(snapshot.version, 2U);
+}
+
+// Readers racing with the writer never observe a torn value
+TEST_F(SharedLatestValueTest, ConcurrentReadersNeverSeeTornValues)
+{
+    using Block = std::array<float, 16>;
+    SharedLatestValue<Block> latest("SharedLatestValueTest");
+    std::atomic<bool> done{false};
+
+    std::thread writer_thread([&latest, &done]()
+                              {
+        Block block{};
+        for (int i = 1; i <= 20000; ++i)
+        {
+            block.fill(static_cast<float>(i));
+            latest.write(block);
+        }
+        done = true; });
+
+    std::thread reader_thread([&latest, &done]()
+                              {
+        std::uint64_t last_version = 0U;
+        while (!done)
+        {
+            const auto snapshot = latest.snapshot();
+            EXPECT_GE(snapshot.version, last_version);
+            last_version = snapshot.version;
+            for (const auto value : snapshot.value)
+            {
+                EXPECT_EQ(value, snapshot.value[0]);
+            }
+        } });
+
+    writer_thread.join();
+    reader_thread.join();
+    EXPECT_EQ(latest.read()[15], 20000.0F);
+}
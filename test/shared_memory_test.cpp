@@ -3,12 +3,26 @@
 /// @copyright (c) Jean Frantz René
 
 #include <gtest/gtest.h>
+#include <array>
 #include <thread>
 #include <chrono>
 #include <boost/interprocess/shared_memory_object.hpp>
-#include "image.h"
 #include "shared_memory.h"
 
+namespace
+{
+/// A multi-element payload placed in shared memory as is.
+using Frame = std::array<float, 16>;
+
+/// Build a frame with every element set to a value.
+Frame filled(float value)
+{
+    Frame frame{};
+    frame.fill(value);
+    return frame;
+}
+} // namespace
+
 // Test fixture for SharedMemory
 class SharedMemoryTest : public ::testing::Test
 {
@@ -78,84 +92,276 @@ protected:
     }
 };
 
-// The data to be written to shared memory is of type std::vector<float>.
+// The data to be written to shared memory is of type Frame.
 
 // Write to shared memory test
-TEST_F(SharedMemoryTest, WriteVectorFloatToSharedMemory)
+TEST_F(SharedMemoryTest, WriteArrayFloatToSharedMemory)
 {
-    std::vector<float> data(1000, 42.0F);
-    performSharedMemoryTest(data);
+    performSharedMemoryTest(filled(42.0F));
 }
 
 // Read from shared memory Test
-TEST_F(SharedMemoryTest, ReadVectorFloatFromSharedMemory)
+TEST_F(SharedMemoryTest, ReadArrayFloatFromSharedMemory)
 {
-    std::vector<float> data(1000, 42.0F);
-    performSharedMemoryTest(data);
+    performSharedMemoryTest(filled(42.0F));
 }
 
 // Concurrent access to shared memory Test
-TEST_F(SharedMemoryTest, ConcurrentAccessVectorFloat)
+TEST_F(SharedMemoryTest, ConcurrentAccessArrayFloat)
 {
-    std::vector<float> data(1000, 42.0F); // Vector with 1000 elements, each initialized to 42.0f
-    performConcurrentAccessTest(data);
+    performConcurrentAccessTest(filled(42.0F));
 }
 
-// The data to be written to shared memory is of type Image<std::size_t>.
+// Fail to write due to nullptr shared_data_ with Frame.
+TEST_F(SharedMemoryTest, WriteFailureDueToNullptr)
+{
+    SharedMemory<Frame> sharedMemory("SharedMemoryTest", sizeof(Frame));
+
+    // Set shared_data_ to nullptr
+    sharedMemory.setSharedDataNullptr();
+
+    const auto status = sharedMemory.write(filled(255.0F));
+    EXPECT_EQ(status, SharedMemory<Frame>::WriteStatus::Failure);
+}
 
-// Write image to shared memory test
-TEST_F(SharedMemoryTest, WriteImageToSharedMemory)
+// Fail to read due to nullptr shared_data_ with Frame.
+TEST_F(SharedMemoryTest, ReadFailureDueToNullptr)
 {
-    Image<std::size_t> image(100U, 100U);                                                               // 100x100 image
-    std::vector<std::size_t> data(image.size() * image.num_channels(), static_cast<std::size_t>(255U)); // Fill with white color
-    image = Image<std::size_t>(data, 100U, 100U);
+    SharedMemory<Frame> sharedMemory("SharedMemoryTest", sizeof(Frame));
+
+    // Set shared_data_ to nullptr
+    sharedMemory.setSharedDataNullptr();
 
-    performSharedMemoryTest(image);
+    EXPECT_THROW(sharedMemory.read(), std::runtime_error);
 }
 
-// Read image from shared memory test
-TEST_F(SharedMemoryTest, ReadImageFromSharedMemory)
+// Loaned slots give the writer and the reader the same data in shared memory.
+TEST_F(SharedMemoryTest, LoanedWriteAndReadShareTheSlot)
 {
-    Image<std::size_t> image(100U, 100U);
-    std::vector<std::size_t> data(image.size() * image.num_channels(), static_cast<std::size_t>(255U));
-    image = Image<std::size_t>(data, 100U, 100U);
+    SharedMemory<Frame> sharedMemory("SharedMemoryTest", sizeof(Frame));
+
+    const Frame *written = nullptr;
+    {
+        auto loan = sharedMemory.acquire_write_slot();
+        loan->fill(0.0F);
+        (*loan)[3] = 255.0F;
+        written = &*loan;
+        EXPECT_EQ(loan.commit(), SharedMemory<Frame>::WriteStatus::Success);
+        EXPECT_EQ(loan.commit(), SharedMemory<Frame>::WriteStatus::Failure);
+    }
+
+    auto loan = sharedMemory.acquire_read_slot();
+    EXPECT_EQ(&*loan, written);
+    EXPECT_EQ((*loan)[3], 255.0F);
+    loan.release();
 
-    performSharedMemoryTest(image);
+    // The slot is released, so the writer can loan it again.
+    auto next = sharedMemory.acquire_write_slot();
+    EXPECT_EQ(next.commit(), SharedMemory<Frame>::WriteStatus::Success);
 }
 
-// Concurrent access to shared memory Test
-TEST_F(SharedMemoryTest, ConcurrentAccess)
+// A read loan waits for a committed write loan.
+TEST_F(SharedMemoryTest, ConcurrentLoans)
+{
+    SharedMemory<Frame> sharedMemory("SharedMemoryTest", sizeof(Frame));
+
+    std::thread writer_thread([&sharedMemory]()
+                              {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto loan = sharedMemory.acquire_write_slot();
+        loan->fill(42.0F);
+        loan.commit(); });
+
+    std::thread reader_thread([&sharedMemory]()
+                              {
+        const auto loan = sharedMemory.acquire_read_slot();
+        EXPECT_EQ(*loan, filled(42.0F)); });
+
+    writer_thread.join();
+    reader_thread.join();
+}
+
+// Fail to loan due to nullptr shared_data_.
+TEST_F(SharedMemoryTest, LoanFailureDueToNullptr)
 {
-    Image<std::size_t> image(100U, 100U);
-    std::vector<std::size_t> data(image.size() * image.num_channels(), static_cast<std::size_t>(255U));
-    image = Image<std::size_t>(data, 100U, 100U);
+    SharedMemory<int> sharedMemory("SharedMemoryTest", sizeof(int));
+    sharedMemory.setSharedDataNullptr();
 
-    performConcurrentAccessTest(image);
+    EXPECT_THROW(sharedMemory.acquire_write_slot(), std::runtime_error);
+    EXPECT_THROW(sharedMemory.acquire_read_slot(), std::runtime_error);
 }
 
-// Fail to write due to nullptr shared_data_ with Image<std::size_t>.
-TEST_F(SharedMemoryTest, WriteFailureDueToNullptr)
+// Write and read with the futex notification backend.
+TEST_F(SharedMemoryTest, FutexNotificationWriteAndRead)
 {
-    SharedMemory<Image<std::size_t>> sharedMemory("SharedMemoryTest", sizeof(Image<std::size_t>));
+    SharedMemoryOptions options;
+    options.notification = Notification::Futex;
+    SharedMemory<int> sharedMemory("SharedMemoryTest", sizeof(int), options);
 
-    // Set shared_data_ to nullptr
+    EXPECT_EQ(sharedMemory.write(42), SharedMemory<int>::WriteStatus::Success);
+    EXPECT_EQ(sharedMemory.read(), 42);
+}
+
+// A reader parked on the futex is woken by the writer, with and without spinning.
+TEST_F(SharedMemoryTest, FutexNotificationConcurrentAccess)
+{
+    for (const std::uint32_t spin_count : {0U, 100000U})
+    {
+        SharedMemoryOptions options;
+        options.notification = Notification::Futex;
+        options.spin_count = spin_count;
+        SharedMemory<Frame> sharedMemory("SharedMemoryTest", sizeof(Frame), options);
+        const auto data = filled(42.0F);
+
+        std::thread writer_thread([&sharedMemory, &data]()
+                                  {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            sharedMemory.write(data); });
+
+        std::thread reader_thread([&sharedMemory, &data]()
+                                  { EXPECT_EQ(sharedMemory.read(), data); });
+
+        writer_thread.join();
+        reader_thread.join();
+    }
+}
+
+// Loans use the futex backend as well.
+TEST_F(SharedMemoryTest, FutexNotificationLoans)
+{
+    SharedMemoryOptions options;
+    options.notification = Notification::Futex;
+    SharedMemory<float> sharedMemory("SharedMemoryTest", sizeof(float), options);
+
+    std::thread reader_thread([&sharedMemory]()
+                              { EXPECT_EQ(*sharedMemory.acquire_read_slot(), 1.5F); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto loan = sharedMemory.acquire_write_slot();
+    *loan = 1.5F;
+    loan.commit();
+    reader_thread.join();
+}
+
+// try_read returns nothing until new data is written, and consumes it.
+TEST_F(SharedMemoryTest, TryRead)
+{
+    SharedMemory<int> sharedMemory("SharedMemoryTest", sizeof(int));
+    EXPECT_FALSE(sharedMemory.try_read().has_value());
+
+    sharedMemory.write(7);
+    EXPECT_EQ(sharedMemory.try_read(), std::optional<int>(7));
+    EXPECT_FALSE(sharedMemory.try_read().has_value());
+}
+
+// read_for and read_until time out without new data, with both notification backends.
+TEST_F(SharedMemoryTest, TimedReadTimesOut)
+{
+    for (const auto notification : {Notification::Condition, Notification::Futex})
+    {
+        SharedMemoryOptions options;
+        options.notification = notification;
+        SharedMemory<float> sharedMemory("SharedMemoryTest", sizeof(float), options);
+
+        const auto start = std::chrono::steady_clock::now();
+        EXPECT_FALSE(sharedMemory.read_for(std::chrono::milliseconds(20)).has_value());
+        EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+        EXPECT_FALSE(sharedMemory.read_until(std::chrono::steady_clock::now() + std::chrono::milliseconds(5)).has_value());
+    }
+}
+
+// read_for returns data written before the timeout, with both notification backends.
+TEST_F(SharedMemoryTest, TimedReadGetsData)
+{
+    for (const auto notification : {Notification::Condition, Notification::Futex})
+    {
+        SharedMemoryOptions options;
+        options.notification = notification;
+        SharedMemory<Frame> sharedMemory("SharedMemoryTest", sizeof(Frame), options);
+        const auto data = filled(42.0F);
+
+        std::thread writer_thread([&sharedMemory, &data]()
+                                  {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            sharedMemory.write(data); });
+
+        EXPECT_EQ(sharedMemory.read_for(std::chrono::seconds(5)), std::optional<Frame>(data));
+        writer_thread.join();
+    }
+}
+
+// Fail to read with a timeout due to nullptr shared_data_.
+TEST_F(SharedMemoryTest, TimedReadFailureDueToNullptr)
+{
+    SharedMemory<int> sharedMemory("SharedMemoryTest", sizeof(int));
     sharedMemory.setSharedDataNullptr();
 
-    Image<std::size_t> image(100U, 100U);
-    std::vector<std::size_t> data(image.size() * image.num_channels(), static_cast<std::size_t>(255U));
-    image = Image<std::size_t>(data, 100U, 100U);
+    EXPECT_THROW(sharedMemory.try_read(), std::runtime_error);
+    EXPECT_THROW(sharedMemory.read_for(std::chrono::milliseconds(1)), std::runtime_error);
+}
+
+// read_into copies the data into the caller's object.
+TEST_F(SharedMemoryTest, ReadIntoCallerObject)
+{
+    SharedMemory<Frame> sharedMemory("SharedMemoryTest", sizeof(Frame));
+    Frame out{};
 
-    const auto status = sharedMemory.write(image);
-    EXPECT_EQ(status, SharedMemory<Image<std::size_t>>::WriteStatus::Failure);
+    sharedMemory.write(filled(42.0F));
+    sharedMemory.read_into(out);
+    EXPECT_EQ(out, filled(42.0F));
 }
 
-// Fail to read due to nullptr shared_data_ with Image<std::size_t>.
-TEST_F(SharedMemoryTest, ReadFailureDueToNullptr)
+// An rvalue write copies the data and leaves the caller's object unchanged.
+TEST_F(SharedMemoryTest, RvalueWriteCopiesData)
 {
-    SharedMemory<Image<std::size_t>> sharedMemory("SharedMemoryTest", sizeof(Image<std::size_t>));
+    SharedMemory<Frame> sharedMemory("SharedMemoryTest", sizeof(Frame));
+    auto first = filled(1.0F);
 
-    // Set shared_data_ to nullptr
+    EXPECT_EQ(sharedMemory.write(std::move(first)), SharedMemory<Frame>::WriteStatus::Success);
+    EXPECT_EQ(first, filled(1.0F));
+    EXPECT_EQ(sharedMemory.read(), filled(1.0F));
+}
+
+// Fail to write an rvalue or read into due to nullptr shared_data_.
+TEST_F(SharedMemoryTest, ReadIntoAndRvalueWriteFailureDueToNullptr)
+{
+    SharedMemory<Frame> sharedMemory("SharedMemoryTest", sizeof(Frame));
     sharedMemory.setSharedDataNullptr();
 
-    EXPECT_THROW(sharedMemory.read(), std::runtime_error);
+    auto data = filled(1.0F);
+    EXPECT_EQ(sharedMemory.write(std::move(data)), SharedMemory<Frame>::WriteStatus::Failure);
+    EXPECT_THROW(sharedMemory.read_into(data), std::runtime_error);
+}
+
+// A late consumer attaches without resetting the writer's state.
+TEST_F(SharedMemoryTest, AttachKeepsWriterState)
+{
+    SharedMemory<int> writer("SharedMemoryTest", sizeof(int));
+    writer.write(42);
+
+    SharedMemoryOptions options;
+    options.segment.open_mode = OpenMode::Attach;
+    {
+        SharedMemory<int> reader("SharedMemoryTest", sizeof(int), options);
+        EXPECT_EQ(reader.try_read(), std::optional<int>(42));
+
+        writer.write(43);
+    }
+
+    // The attached reader left the segment in place when it went away.
+    SharedMemory<int> reader("SharedMemoryTest", sizeof(int), options);
+    EXPECT_EQ(reader.read(), 43);
+}
+
+// Attaching with a different payload type or size is refused.
+TEST_F(SharedMemoryTest, AttachRejectsMismatchedLayout)
+{
+    SharedMemory<int> writer("SharedMemoryTest", sizeof(int));
+
+    SharedMemoryOptions options;
+    options.segment.open_mode = OpenMode::Attach;
+    EXPECT_THROW(SharedMemory<float>("SharedMemoryTest", sizeof(int), options), std::runtime_error);
+    EXPECT_THROW(SharedMemory<int>("SharedMemoryTest", 2U * sizeof(int), options), std::runtime_error);
+    EXPECT_THROW(SharedMemory<int>("SharedMemoryTestMissing", sizeof(int), options), std::runtime_error);
 }
@@ -0,0 +1,155 @@
+/// @file
+/// @brief Unit tests for the SharedRingBuffer class.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "shared_ring_buffer.h"
+
+// Test fixture for SharedRingBuffer
+class SharedRingBufferTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory object used in the tests.
+    ///
+    void TearDown() override
+    {
+        boost::interprocess::shared_memory_object::remove("SharedRingBufferTest");
+    }
+};
+
+// Data is read back in the order it was written
+TEST_F(SharedRingBufferTest, ReadsInWriteOrder)
+{
+    SharedRingBuffer<int> ring("SharedRingBufferTest", 4U);
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(ring.write(i), SharedRingBuffer<int>::WriteStatus::Success);
+    }
+    EXPECT_EQ(ring.size(), 4U);
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(ring.read(), i);
+    }
+    EXPECT_EQ(ring.size(), 0U);
+}
+
+// A full ring rejects writes instead of overwriting unread slots
+TEST_F(SharedRingBufferTest, WriteFailsWhenFull)
+{
+    SharedRingBuffer<float> ring("SharedRingBufferTest", 2U);
+    EXPECT_EQ(ring.write(1.0F), SharedRingBuffer<float>::WriteStatus::Success);
+    EXPECT_EQ(ring.write(2.0F), SharedRingBuffer<float>::WriteStatus::Success);
+    EXPECT_EQ(ring.write(3.0F), SharedRingBuffer<float>::WriteStatus::Full);
+
+    EXPECT_EQ(ring.read(), 1.0F);
+    EXPECT_EQ(ring.write(3.0F), SharedRingBuffer<float>::WriteStatus::Success);
+    EXPECT_EQ(ring.read(), 2.0F);
+    EXPECT_EQ(ring.read(), 3.0F);
+}
+
+// try_read returns nothing on an empty ring
+TEST_F(SharedRingBufferTest, TryReadOnEmptyRing)
+{
+    SharedRingBuffer<float> ring("SharedRingBufferTest", 2U);
+    EXPECT_FALSE(ring.try_read().has_value());
+
+    ring.write(42.0F);
+    const auto value = ring.try_read();
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(*value, 42.0F);
+}
+
+// A fast producer does not lose frames while the consumer keeps up
+TEST_F(SharedRingBufferTest, ConcurrentProducerConsumerKeepsEveryFrame)
+{
+    constexpr int kFrames = 10000;
+    SharedRingBuffer<int> ring("SharedRingBufferTest", 16U);
+
+    std::thread writer_thread([&ring]()
+                              {
+        for (int i = 0; i < kFrames; ++i)
+        {
+            while (ring.write(i) == SharedRingBuffer<int>::WriteStatus::Full)
+            {
+                std::this_thread::yield();
+            }
+        } });
+
+    std::thread reader_thread([&ring]()
+                              {
+        for (int i = 0; i < kFrames; ++i)
+        {
+            EXPECT_EQ(ring.read(), i);
+        } });
+
+    writer_thread.join();
+    reader_thread.join();
+    EXPECT_EQ(ring.size(), 0U);
+}
+
+// A batch is written up to the free space and drained in order
+TEST_F(SharedRingBufferTest, WriteAndReadBatch)
+{
+    SharedRingBuffer<float> ring("SharedRingBufferTest", 8U);
+    const std::vector<float> samples{1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F};
+
+    EXPECT_EQ(ring.write_batch(samples), 6U);
+    EXPECT_EQ(ring.write_batch(samples), 2U);
+    EXPECT_EQ(ring.write_batch(samples), 0U);
+
+    std::vector<float> out(10U);
+    EXPECT_EQ(ring.read_batch(out, 4U), 4U);
+    EXPECT_EQ(std::vector<float>(out.begin(), out.begin() + 4), std::vector<float>(samples.begin(), samples.begin() + 4));
+
+    EXPECT_EQ(ring.read_batch(out, out.size()), 4U);
+    EXPECT_EQ(out[0], 5.0F);
+    EXPECT_EQ(out[1], 6.0F);
+    EXPECT_EQ(out[2], 1.0F);
+    EXPECT_EQ(out[3], 2.0F);
+    EXPECT_EQ(ring.size(), 0U);
+}
+
+// Batches keep every sample when producer and consumer run concurrently
+TEST_F(SharedRingBufferTest, ConcurrentBatchesKeepEverySample)
+{
+    constexpr int kSamples = 64 * 1600;
+    SharedRingBuffer<int> ring("SharedRingBufferTest", 256U);
+
+    std::thread writer_thread([&ring]()
+                              {
+        std::vector<int> batch(64U);
+        int next = 0;
+        while (next < kSamples)
+        {
+            for (auto &sample : batch)
+            {
+                sample = next++;
+            }
+            std::span<const int> pending(batch);
+            while (!pending.empty())
+            {
+                pending = pending.subspan(ring.write_batch(pending));
+                std::this_thread::yield();
+            }
+        } });
+
+    std::thread reader_thread([&ring]()
+                              {
+        std::vector<int> batch(100U);
+        int expected = 0;
+        while (expected < kSamples)
+        {
+            const auto count = ring.read_batch(batch, batch.size());
+            for (std::size_t i = 0U; i < count; ++i)
+            {
+                EXPECT_EQ(batch[i], expected++);
+            }
+        } });
+
+    writer_thread.join();
+    reader_thread.join();
+}
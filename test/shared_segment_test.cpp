@@ -0,0 +1,153 @@
+/// @file
+/// @brief Unit tests for the SharedSegment class.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <thread>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "shared_memory.h"
+#include "shared_segment.h"
+
+// Test fixture for SharedSegment
+class SharedSegmentTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory object used in the tests.
+    ///
+    void TearDown() override
+    {
+        boost::interprocess::shared_memory_object::remove("SharedSegmentTest");
+    }
+};
+
+// The default backing is POSIX shared memory of at least the requested size
+TEST_F(SharedSegmentTest, DefaultBacking)
+{
+    SharedSegment segment("SharedSegmentTest", 10000U);
+    EXPECT_FALSE(segment.hugePages());
+    EXPECT_GE(segment.size(), 10000U);
+    EXPECT_EQ(segment.name(), "SharedSegmentTest");
+    std::memset(segment.address(), 0xAB, 10000U);
+}
+
+// Requesting huge pages without a hugetlbfs mount falls back to shared memory
+TEST_F(SharedSegmentTest, HugePagesFallBackWithoutMount)
+{
+    SegmentOptions options;
+    options.backing = SegmentBacking::HugePages;
+    options.huge_page_mount = "/nonexistent/hugepages";
+
+    SharedSegment segment("SharedSegmentTest", 3U * kHugePageSize, options);
+    EXPECT_FALSE(segment.hugePages());
+    EXPECT_GE(segment.size(), 3U * kHugePageSize);
+    std::memset(segment.address(), 0xCD, 3U * kHugePageSize);
+}
+
+// Huge pages are used when the default mount has pages reserved, and the segment is usable either way
+TEST_F(SharedSegmentTest, HugePagesBackingIsUsable)
+{
+    SharedMemoryOptions options;
+    options.segment.backing = SegmentBacking::HugePages;
+
+    SharedMemory<int> sharedMemory("SharedSegmentTest", sizeof(int), options);
+    if (sharedMemory.hugePages())
+    {
+        SUCCEED() << "Segment is backed by huge pages";
+    }
+    EXPECT_EQ(sharedMemory.write(42), SharedMemory<int>::WriteStatus::Success);
+    EXPECT_EQ(sharedMemory.read(), 42);
+}
+
+// Without warm-up options nothing is pre-faulted or locked
+TEST_F(SharedSegmentTest, NoWarmUpByDefault)
+{
+    SharedSegment segment("SharedSegmentTest", 4096U);
+    EXPECT_FALSE(segment.pagesLocked());
+    EXPECT_EQ(segment.warmUpTime().count(), 0);
+}
+
+// Pre-faulting reports its duration and keeps the content of an already used segment
+TEST_F(SharedSegmentTest, PrefaultKeepsContent)
+{
+    constexpr std::size_t kSize = 64U * 4096U;
+    SharedSegment writer("SharedSegmentTest", kSize);
+    std::memset(writer.address(), 0x42, kSize);
+    writer.markInitialized();
+
+    SegmentOptions options;
+    options.open_mode = OpenMode::Attach;
+    options.prefault = true;
+    options.lock_pages = true;
+    SharedSegment reader("SharedSegmentTest", kSize, options);
+
+    EXPECT_GT(reader.warmUpTime().count(), 0);
+    const auto *bytes = static_cast<const unsigned char *>(reader.address());
+    for (std::size_t i = 0U; i < kSize; i += 4096U)
+    {
+        EXPECT_EQ(bytes[i], 0x42);
+    }
+    // Locking may be refused by RLIMIT_MEMLOCK; the segment stays usable either way.
+    if (!reader.pagesLocked())
+    {
+        SUCCEED() << "mlock refused, segment is not locked";
+    }
+}
+
+// A SharedMemory channel forwards the warm-up options to its segment
+TEST_F(SharedSegmentTest, SharedMemoryWarmUp)
+{
+    SharedMemoryOptions options;
+    options.segment.prefault = true;
+    SharedMemory<float> sharedMemory("SharedSegmentTest", 1024U, options);
+
+    EXPECT_GT(sharedMemory.segment().warmUpTime().count(), 0);
+    sharedMemory.write(1.0F);
+    EXPECT_EQ(sharedMemory.read(), 1.0F);
+}
+
+// Attaching checks the header published by the creator
+TEST_F(SharedSegmentTest, AttachChecksHeader)
+{
+    SegmentOptions attach;
+    attach.open_mode = OpenMode::Attach;
+    attach.attach_timeout = std::chrono::milliseconds(10);
+
+    EXPECT_THROW(SharedSegment("SharedSegmentTest", 4096U, attach), std::runtime_error);
+
+    SharedSegment creator("SharedSegmentTest", 4096U, {}, layoutHash<int>());
+    EXPECT_TRUE(creator.owner());
+    EXPECT_THROW(SharedSegment("SharedSegmentTest", 4096U, attach, layoutHash<int>()), std::runtime_error);
+
+    creator.markInitialized();
+    SharedSegment attached("SharedSegmentTest", 4096U, attach, layoutHash<int>());
+    EXPECT_FALSE(attached.owner());
+    EXPECT_THROW(SharedSegment("SharedSegmentTest", 8192U, attach, layoutHash<int>()), std::runtime_error);
+    EXPECT_THROW(SharedSegment("SharedSegmentTest", 4096U, attach, layoutHash<float>()), std::runtime_error);
+}
+
+// Attaching to an object the creator has not sized yet waits for it instead of failing to map
+TEST_F(SharedSegmentTest, AttachWaitsForCreatorToSizeObject)
+{
+    {
+        // An empty object, as seen between the creator's open and truncate.
+        boost::interprocess::shared_memory_object empty(boost::interprocess::create_only, "SharedSegmentTest", boost::interprocess::read_write);
+    }
+    SegmentOptions attach;
+    attach.open_mode = OpenMode::Attach;
+    attach.attach_timeout = std::chrono::milliseconds(10);
+    EXPECT_THROW(SharedSegment("SharedSegmentTest", 4096U, attach), std::runtime_error);
+
+    attach.attach_timeout = std::chrono::milliseconds(2000);
+    bool attached = false;
+    std::thread attacher([&attach, &attached]()
+                         {
+                             const SharedSegment segment("SharedSegmentTest", 4096U, attach);
+                             attached = !segment.owner(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    SharedSegment creator("SharedSegmentTest", 4096U);
+    creator.markInitialized();
+    attacher.join();
+    EXPECT_TRUE(attached);
+}
@@ -0,0 +1,117 @@
+/// @file
+/// @brief Unit tests for the SharedVariableMemory class.
+/// @copyright (c) Jean Frantz René
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "shared_variable_memory.h"
+
+// Test fixture for SharedVariableMemory
+class SharedVariableMemoryTest : public ::testing::Test
+{
+protected:
+    /// @brief Tear down the test environment.
+    /// It removes the shared memory object used in the tests.
+    ///
+    void TearDown() override
+    {
+        boost::interprocess::shared_memory_object::remove("SharedVariableMemoryTest");
+    }
+};
+
+// Payloads of different lengths round-trip through the same channel
+TEST_F(SharedVariableMemoryTest, VectorsOfVaryingLength)
+{
+    SharedVariableMemory<float> channel("SharedVariableMemoryTest", 1U << 20U);
+    for (std::size_t length : {3U, 1000U, 1U, 50000U})
+    {
+        const std::vector<float> data(length, static_cast<float>(length));
+        EXPECT_EQ(channel.write(data), SharedVariableMemory<float>::WriteStatus::Success);
+        EXPECT_EQ(channel.read(), data);
+    }
+}
+
+// Images of different resolutions keep their shape
+TEST_F(SharedVariableMemoryTest, ImagesOfVaryingResolution)
+{
+    SharedVariableMemory<std::uint8_t> channel("SharedVariableMemoryTest", 1U << 20U);
+    const Image<std::uint8_t> small(std::vector<std::uint8_t>(2 * 3 * 3, 7), 2, 3, 3);
+    const Image<std::uint8_t> large(std::vector<std::uint8_t>(640 * 480, 9), 640, 480);
+
+    channel.write(small);
+    EXPECT_EQ(channel.read_image(), small);
+    channel.write(large);
+    EXPECT_EQ(channel.read_image(), large);
+}
+
+// A second instance reads the payload written through the first in place
+TEST_F(SharedVariableMemoryTest, ReaderSeesPayloadInPlace)
+{
+    SharedVariableMemory<std::size_t> writer("SharedVariableMemoryTest", 1U << 16U);
+    SegmentOptions options;
+    options.open_mode = OpenMode::Attach;
+    const SharedVariableMemory<std::size_t> reader("SharedVariableMemoryTest", 1U << 16U, options);
+
+    std::thread producer([&writer]()
+                         {
+                             auto loan = writer.acquire_write_slot(4, 2);
+                             for (std::size_t i = 0; i < loan->data().size(); ++i)
+                             {
+                                 loan->data()[i] = i;
+                             }
+                             loan.commit(); });
+    {
+        const auto loan = reader.acquire_read_slot();
+        EXPECT_EQ(loan->width(), 4U);
+        EXPECT_EQ(loan->height(), 2U);
+        EXPECT_EQ(loan->readData()[7], 7U);
+    }
+    producer.join();
+}
+
+// A payload larger than the segment is rejected without disturbing the channel
+TEST_F(SharedVariableMemoryTest, PayloadTooLarge)
+{
+    SharedVariableMemory<float> channel("SharedVariableMemoryTest", 1U << 16U);
+    const std::vector<float> huge(1U << 16U);
+
+    EXPECT_EQ(channel.write(huge), SharedVariableMemory<float>::WriteStatus::Failure);
+    EXPECT_THROW(channel.acquire_write_slot(1U << 16U), std::length_error);
+
+    const std::vector<float> fits{1.0F, 2.0F};
+    EXPECT_EQ(channel.write(fits), SharedVariableMemory<float>::WriteStatus::Success);
+    EXPECT_EQ(channel.read(), fits);
+}
+
+// Attaching checks the segment, and creating resets one left over by a crashed writer
+TEST_F(SharedVariableMemoryTest, OpenModes)
+{
+    SegmentOptions attach;
+    attach.open_mode = OpenMode::Attach;
+    attach.attach_timeout = std::chrono::milliseconds(10);
+    EXPECT_THROW(SharedVariableMemory<float>("SharedVariableMemoryTest", 1U << 16U, attach), std::runtime_error);
+
+    const pid_t child = fork();
+    if (child == 0)
+    {
+        // Crash while holding the channel mutex.
+        auto *crashed = new SharedVariableMemory<float>("SharedVariableMemoryTest", 1U << 16U);
+        crashed->write(std::vector<float>{1.0F, 2.0F});
+        new auto(crashed->acquire_write_slot(4U));
+        _exit(0);
+    }
+    ASSERT_GT(child, 0);
+    waitpid(child, nullptr, 0);
+    EXPECT_THROW(SharedVariableMemory<float>("SharedVariableMemoryTest", 1U << 17U, attach), std::runtime_error);
+    EXPECT_THROW(SharedVariableMemory<std::uint8_t>("SharedVariableMemoryTest", 1U << 16U, attach), std::runtime_error);
+
+    SharedVariableMemory<float> creator("SharedVariableMemoryTest", 1U << 16U);
+    EXPECT_EQ(creator.write(std::vector<float>{3.0F}), SharedVariableMemory<float>::WriteStatus::Success);
+    EXPECT_EQ(creator.read(), std::vector<float>{3.0F});
+}
@@ -0,0 +1,102 @@
+/// @file
+/// @brief Republish a recording made with ChannelRecorder on an existing channel.
+/// @copyright (c) Jean Frantz René
+///
+/// Usage: general_inter_p_lib_replay <recording> <channel> [speed|max] [size]
+/// The frame type is detected from the recording. The channel is attached to, so its
+/// consumer must have created it: a SharedMemory channel for int and float frames, whose
+/// data size defaults to 1, and a SharedFlatMemory channel for std::vector<float> and
+/// Image<std::size_t> frames, whose capacity in bytes defaults to the largest recorded frame.
+
+#include "channel_recording.h"
+#include "image.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+/// Republish the frames of a recording on an open channel, return the process exit code.
+template <typename T, typename Channel>
+int publish(const ChannelReplayer<T> &replayer, Channel &channel, const std::string &channel_name, double speed)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const auto published = replayer.replay(channel, speed);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Published " << published << " of " << replayer.size() << " frames on " << channel_name
+              << " in " << elapsed.count() << " s\n";
+    return published == replayer.size() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/// Replay a recording of a trivially copyable T on a SharedMemory channel.
+template <typename T>
+int replayAs(const std::filesystem::path &path, const std::string &channel_name, double speed, std::size_t data_size)
+{
+    const ChannelReplayer<T> replayer(path);
+    SharedMemoryOptions options;
+    options.segment.open_mode = OpenMode::Attach;
+    SharedMemory<T> channel(channel_name, data_size == 0U ? 1U : data_size, options);
+    return publish(replayer, channel, channel_name, speed);
+}
+
+/// Replay a recording of T on a SharedFlatMemory channel.
+template <typename T>
+int replayFlatAs(const std::filesystem::path &path, const std::string &channel_name, double speed, std::size_t capacity)
+{
+    const ChannelReplayer<T> replayer(path);
+    for (std::size_t i = 0U; capacity == 0U && i < replayer.size(); ++i)
+    {
+        capacity = std::max<std::size_t>(capacity, replayer.entry(i).size);
+    }
+    SegmentOptions options;
+    options.open_mode = OpenMode::Attach;
+    SharedFlatMemory<T> channel(channel_name, capacity, options);
+    return publish(replayer, channel, channel_name, speed);
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <recording> <channel> [speed|max] [size]\n"
+                  << "  speed: 1 for the original pace (default), 2 for twice as fast, max for no pacing\n"
+                  << "  size: data size of a SharedMemory channel, capacity in bytes of a SharedFlatMemory channel\n";
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path path = argv[1];
+    const std::string channel_name = argv[2];
+    const std::string speed_arg = argc > 3 ? argv[3] : "1";
+    const double speed = speed_arg == "max" ? 0.0 : std::strtod(speed_arg.c_str(), nullptr);
+    const std::size_t size = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 0U;
+
+    try
+    {
+        if (ChannelReplayer<int>::matches(path))
+        {
+            return replayAs<int>(path, channel_name, speed, size);
+        }
+        if (ChannelReplayer<float>::matches(path))
+        {
+            return replayAs<float>(path, channel_name, speed, size);
+        }
+        if (ChannelReplayer<std::vector<float>>::matches(path))
+        {
+            return replayFlatAs<std::vector<float>>(path, channel_name, speed, size);
+        }
+        if (ChannelReplayer<Image<std::size_t>>::matches(path))
+        {
+            return replayFlatAs<Image<std::size_t>>(path, channel_name, speed, size);
+        }
+        std::cerr << path << " is not a recording of a supported frame type\n";
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << '\n';
+    }
+    return EXIT_FAILURE;
+}